@@ -0,0 +1,69 @@
+#include <catch2/catch.hpp>
+
+#include "ds/graph.hpp"
+
+#include <random>
+
+using namespace std;
+using namespace P;
+
+/*
+ * Random directed graph: 10^4 vertices, 3 * 10^4 edges
+ *
+ * reachability against one bfs per vertex
+ */
+TEST_CASE("all-pairs reachability", "[!benchmark][graph]") {
+  const int n = 10'000, m = 30'000;
+  mt19937 gen;
+  uniform_int_distribution<> dis(0, n - 1);
+  AdjList al(n), dag(n);
+  for (int q = 0; q < m; ++q) {
+    int u = dis(gen), v = dis(gen);
+    al[u].push_back(v);
+    if (u < v) dag[u].push_back(v);
+  }
+
+  BENCHMARK("reachability") { return al.reachability().degree(0); };
+  BENCHMARK("reachability dag") { return dag.reachability().degree(0); };
+  BENCHMARK("bfs from every vertex") {
+    long long c = 0;
+    for (int u = 0; u < n; ++u) al.bfs(u, [&c](Node) { ++c; });
+    return c;
+  };
+}
+
+/*
+ * Random weighted graph: 2000 vertices, 10^4 edges
+ *
+ * blocked floyd_warshall against the textbook triple loop and one dijkstra
+ * per vertex
+ */
+TEST_CASE("all-pairs shortest paths", "[!benchmark][graph]") {
+  const int n = 2000, m = 10'000;
+  mt19937 gen;
+  uniform_int_distribution<> dis(0, n - 1), wdis(1, 100);
+  WeightedAdjList al(n);
+  for (int q = 0; q < m; ++q) al[dis(gen)].push_back({dis(gen), wdis(gen)});
+
+  BENCHMARK("floyd_warshall 1 thread") {
+    return al.floyd_warshall(1)[{0, n - 1}];
+  };
+  BENCHMARK("floyd_warshall") { return al.floyd_warshall()[{0, n - 1}]; };
+  BENCHMARK("floyd_warshall textbook") {
+    AdjMat d(n);
+    for (int u = 0; u < n; ++u)
+      for (int v = 0; v < n; ++v) d[{u, v}] = u == v ? 0 : INF;
+    for (int u = 0; u < n; ++u)
+      for (auto [v, w] : al[u]) d[{u, v}] = min(d[{u, v}], w);
+    for (int k = 0; k < n; ++k)
+      for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+          d[{i, j}] = min(d[{i, j}], d[{i, k}] + d[{k, j}]);
+    return d[{0, n - 1}];
+  };
+  BENCHMARK("dijkstra from every vertex") {
+    long long c = 0;
+    for (int u = 0; u < n; ++u) c += al.dijkstra(u)[n - 1];
+    return c;
+  };
+}
@@ -0,0 +1,61 @@
+#include <catch2/catch.hpp>
+
+#include "ds/bit_adjmat.hpp"
+#include "ds/graph.hpp"
+
+#include <algorithm>
+#include <random>
+
+using namespace std;
+using namespace P;
+
+/*
+ * Random undirected graph: 8000 vertices, average degree 200
+ *
+ * triangles on the bit matrix against merging sorted adjacency lists
+ */
+TEST_CASE("bit adjacency matrix", "[!benchmark][graph]") {
+  const int n = 8000, m = 800'000;
+  mt19937 gen;
+  uniform_int_distribution<> dis(0, n - 1);
+  BitAdjMat mat(n);
+  for (int q = 0; q < m; ++q) {
+    int u = dis(gen), v = dis(gen);
+    if (u == v) continue;
+    mat.set(u, v);
+    mat.set(v, u);
+  }
+  AdjList al(n);
+  for (int u = 0; u < n; ++u)
+    for (int v = 0; v < n; ++v)
+      if (mat.test(u, v)) al[u].push_back(v);
+
+  BENCHMARK("triangles bit matrix") { return mat.triangles(); };
+  BENCHMARK("triangles sorted lists") {
+    long long c = 0;
+    for (int u = 0; u < n; ++u)
+      for (int v : al[u]) {
+        if (v <= u) continue;
+        auto a = al[u].begin(), b = al[v].begin();
+        while (a != al[u].end() && b != al[v].end()) {
+          if (*a < *b)
+            ++a;
+          else if (*b < *a)
+            ++b;
+          else
+            ++c, ++a, ++b;
+        }
+      }
+    return c / 3;
+  };
+  BENCHMARK("transpose") { return mat.transpose().degree(0); };
+
+  BitAdjMat dag(2000);
+  for (int q = 0; q < 4000; ++q) {
+    int u = dis(gen) % 2000, v = dis(gen) % 2000;
+    if (u < v) dag.set(u, v);
+  }
+  BENCHMARK("transitive_closure 2000") {
+    return dag.transitive_closure().degree(0);
+  };
+}
@@ -0,0 +1,43 @@
+#include <catch2/catch.hpp>
+
+#include "ds/concurrent_dsuf.hpp"
+#include "ds/dsuf.hpp"
+#include "util/parallel.hpp"
+
+#include <random>
+
+using namespace std;
+using namespace P;
+
+/*
+ * n random unions on n elements; edges are generated on the fly per thread so
+ * only the parent array is resident (400 MB for n = 10^8)
+ */
+TEST_CASE("random unions scaling", "[!benchmark][concurrent_dsuf]") {
+  const int n = 100'000'000;
+  const int m = n;
+
+  BENCHMARK_ADVANCED("DSUF 1 thread")(Catch::Benchmark::Chronometer meter) {
+    meter.measure([&] {
+      DSUF d(n);
+      mt19937 gen(0);
+      uniform_int_distribution<> dis(0, n - 1);
+      for (int q = 0; q < m; ++q) d.uni(dis(gen), dis(gen));
+      return d.size(0);
+    });
+  };
+  for (int nt = 1; nt <= num_threads(); nt *= 2) {
+    BENCHMARK_ADVANCED("ConcurrentDSUF " + to_string(nt) + " threads")
+    (Catch::Benchmark::Chronometer meter) {
+      meter.measure([&] {
+        ConcurrentDSUF d(n);
+        run_threads(nt, [&](int t) {
+          mt19937 gen(t);
+          uniform_int_distribution<> dis(0, n - 1);
+          for (int q = 0; q < m / nt; ++q) d.uni(dis(gen), dis(gen));
+        });
+        return d.root(0);
+      });
+    };
+  }
+}
@@ -0,0 +1,30 @@
+#include <catch2/catch.hpp>
+
+#include "ds/graph.hpp"
+
+#include <random>
+
+using namespace std;
+using namespace P;
+
+/*
+ * Random undirected graph: 10^6 vertices, 5 * 10^6 edges stored both ways
+ * (10^7 adjacency entries)
+ */
+TEST_CASE("connected components", "[!benchmark][graph]") {
+  const int n = 1'000'000, m = 5'000'000;
+  mt19937 gen;
+  uniform_int_distribution<> dis(0, n - 1);
+  AdjList al(n);
+  for (int q = 0; q < m; ++q) {
+    int u = dis(gen), v = dis(gen);
+    al[u].push_back(v);
+    al[v].push_back(u);
+  }
+
+  BENCHMARK("bfs") { return al.connected_components_bfs(); };
+  for (int nt = 1; nt <= num_threads(); nt *= 2)
+    BENCHMARK("afforest " + to_string(nt) + " threads") {
+      return al.connected_components(nt);
+    };
+}
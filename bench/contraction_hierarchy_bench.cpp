@@ -0,0 +1,47 @@
+#include <catch2/catch.hpp>
+
+#include "ds/contraction_hierarchy.hpp"
+#include "grid.hpp"
+
+#include <filesystem>
+#include <random>
+
+using namespace std;
+using namespace P;
+namespace fs = std::filesystem;
+
+/*
+ * Road-like graph: side x side grid (see grid.hpp), local weights in
+ * [10, 100]
+ */
+TEST_CASE("contraction hierarchy", "[!benchmark][graph][ch]") {
+  const int side = 300;
+  auto g = grid(side, 10, 100, true);
+
+  for (int nt = 1; nt <= num_threads(); nt *= 2)
+    BENCHMARK_ADVANCED("preprocessing " + to_string(nt) + " threads")
+    (Catch::Benchmark::Chronometer meter) {
+      meter.measure([&] { return ContractionHierarchy(g, nt).arcs(); });
+    };
+
+  ContractionHierarchy ch(g);
+  auto file = fs::temp_directory_path() / "pdsalgo_ch_bench.bin";
+  ch.save(file.string());
+  BENCHMARK("load") { return ContractionHierarchy::load(file.string()); };
+  fs::remove(file);
+
+  mt19937 gen(side);
+  uniform_int_distribution<> dis(0, side * side - 1);
+  DijkstraWorkspace<> ws;
+  BidirectionalWorkspace bws;
+  auto rev = g.transpose();
+  BENCHMARK("query dijkstra early exit") {
+    return g.dijkstra(ws, dis(gen), dis(gen));
+  };
+  BENCHMARK("query bidirectional dijkstra") {
+    return g.bidirectional_dijkstra(rev, bws, dis(gen), dis(gen));
+  };
+  BENCHMARK("query contraction hierarchy") {
+    return ch.query(bws, dis(gen), dis(gen));
+  };
+}
@@ -0,0 +1,61 @@
+#include <catch2/catch.hpp>
+
+#include "ds/csr_graph.hpp"
+
+#include <random>
+
+using namespace std;
+using namespace P;
+
+/*
+ * Random directed graph: 4 * 10^6 vertices, 2 * 10^7 weighted edges
+ *
+ * topological_sort runs on the DAG keeping the edges with u < v
+ */
+TEST_CASE("csr graph traversal", "[!benchmark][graph][csr]") {
+  const int n = 4'000'000, m = 20'000'000;
+  mt19937 gen;
+  uniform_int_distribution<> dis(0, n - 1), wdis(1, 100);
+  WeightedAdjList al(n), dag(n);
+  for (int q = 0; q < m; ++q) {
+    int u = dis(gen), v = dis(gen), w = wdis(gen);
+    al[u].push_back({v, w});
+    if (u < v) dag[u].push_back({v, w});
+  }
+  WeightedCsrGraph g(al), gdag(dag);
+
+  auto count = [](auto const& graph) {
+    long long c = 0;
+    graph.bfs(0, [&c](Node x) { c += x; });
+    return c;
+  };
+  BENCHMARK("bfs adjlist") { return count(al); };
+  BENCHMARK("bfs csr") { return count(g); };
+
+  auto pre = [](auto const& graph) {
+    long long c = 0;
+    graph.dfs(0, [&c](Node x) { c += x; });
+    return c;
+  };
+  BENCHMARK("dfs adjlist") { return pre(al); };
+  BENCHMARK("dfs csr") { return pre(g); };
+
+  auto depth = [](auto const& graph) {
+    long long c = 0;
+    graph.bfs_depth(0, [&c](Node, int d) { c += d; });
+    return c;
+  };
+  BENCHMARK("bfs_depth adjlist") { return depth(al); };
+  BENCHMARK("bfs_depth csr") { return depth(g); };
+
+  auto topo = [](auto const& graph) {
+    long long c = 0;
+    graph.topological_sort([&c](Node x) { c ^= x; });
+    return c;
+  };
+  BENCHMARK("topological_sort adjlist") { return topo(dag); };
+  BENCHMARK("topological_sort csr") { return topo(gdag); };
+
+  BENCHMARK("dijkstra adjlist") { return al.dijkstra(0); };
+  BENCHMARK("dijkstra csr") { return g.dijkstra(0); };
+}
@@ -0,0 +1,32 @@
+#include <catch2/catch.hpp>
+
+#include "ds/csr_graph.hpp"
+
+#include <random>
+
+using namespace std;
+using namespace P;
+
+/*
+ * Random directed graph: 2 * 10^6 vertices, 1.6 * 10^7 edges, weights in
+ * [1, 255]
+ */
+TEST_CASE("delta stepping", "[!benchmark][graph]") {
+  const int n = 2'000'000, m = 16'000'000;
+  mt19937 gen;
+  uniform_int_distribution<> dis(0, n - 1), wdis(1, 255);
+  vector<pair<int, WeightedNode>> edges(m);
+  for (auto& e : edges) e = {dis(gen), {dis(gen), wdis(gen)}};
+  WeightedCsrGraph g(n, edges);
+  edges = {};
+
+  BENCHMARK("dijkstra") { return g.dijkstra(0); };
+  for (int delta : {8, 32, 128})
+    BENCHMARK("delta " + to_string(delta) + " 1 thread") {
+      return g.delta_stepping(0, delta, 1);
+    };
+  for (int nt = 1; nt <= num_threads(); nt *= 2)
+    BENCHMARK("delta auto " + to_string(nt) + " threads") {
+      return g.delta_stepping(0, 0, nt);
+    };
+}
@@ -0,0 +1,64 @@
+#include <catch2/catch.hpp>
+
+#include "ds/csr_graph.hpp"
+#include "ds/monotone_queue.hpp"
+#include "grid.hpp"
+
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace P;
+
+namespace {
+// dijkstra before the workspace: lazy deletion on a binary priority_queue
+template <typename G>
+vector<int> lazy_dijkstra(G const& g, int root) {
+  vector<int> dis(g.N(), INF);
+  vector<int> done(g.N());
+  dis[root] = 0;
+  using E = pair<int, int>;
+  priority_queue<E, vector<E>, greater<E>> q;
+  q.push({0, root});
+  while (!q.empty()) {
+    auto [_, u] = q.top();
+    q.pop();
+    if (done[u]) continue;
+    done[u] = true;
+    for (auto [v, w] : g[u])
+      if (dis[u] + w < dis[v]) q.push({dis[v] = dis[u] + w, v});
+  }
+  return dis;
+}
+}  // namespace
+
+TEST_CASE("dijkstra queues", "[!benchmark][graph][dijkstra]") {
+  const int side = 1000, maxw = 100;  // 10^6 vertices
+  auto g = grid(side, 1, maxw);
+  DijkstraWorkspace<> heap;
+  DijkstraWorkspace<RadixHeap> radix;
+  DijkstraWorkspace<BucketQueue> dial(BucketQueue{maxw});
+
+  BENCHMARK("lazy priority_queue") { return lazy_dijkstra(g, 0); };
+  BENCHMARK("indexed 4-ary heap") { return g.dijkstra(heap, 0), heap.dis[1]; };
+  BENCHMARK("radix heap") { return g.dijkstra(radix, 0), radix.dis[1]; };
+  BENCHMARK("dial buckets") { return g.dijkstra(dial, 0), dial.dis[1]; };
+
+  // point-to-point queries between nearby vertices
+  mt19937 gen;
+  uniform_int_distribution<> dis(0, side * side - 1), off(-10, 10);
+  auto query = [&] {
+    int s = dis(gen);
+    return pair{s, clamp(s + off(gen) * side + off(gen), 0, side * side - 1)};
+  };
+  BENCHMARK("point-to-point full") {
+    auto [s, t] = query();
+    return lazy_dijkstra(g, s)[t];
+  };
+  BENCHMARK("point-to-point early exit") {
+    auto [s, t] = query();
+    return g.dijkstra(heap, s, t);
+  };
+}
@@ -0,0 +1,94 @@
+#include <catch2/catch.hpp>
+
+#include "ds/dsuf.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace P;
+
+namespace {
+// DSUF before path halving: recursive root, size packed in p
+class RecursiveDSUF {
+ public:
+  RecursiveDSUF(int n) : p(n, -1) {}
+  int root(int i) { return p[i] < 0 ? i : p[i] = root(p[i]); }
+  void uni(int u, int v) {
+    u = root(u);
+    v = root(v);
+    if (u == v) return;
+    if (p[u] > p[v]) swap(u, v);
+    p[u] += p[v];
+    p[v] = u;
+  }
+
+ private:
+  vector<int> p;
+};
+
+/*
+ * Adversarial order for union by size/rank: merging equal-sized trees round
+ * by round builds binomial trees of depth log2(n), then every element is
+ * queried once, deepest paths first
+ */
+template <typename D>
+long long binomial_rounds(int n) {
+  D d(n);
+  for (int s = 1; s < n; s *= 2)
+    for (int i = 0; i + s < n; i += 2 * s) d.uni(i + s, i);
+  long long sum = 0;
+  for (int i = n - 1; i >= 0; --i) sum += d.root(i);
+  return sum;
+}
+
+/*
+ * uni(i, i + 1) in order: union by size/rank keeps every tree a star of
+ * depth 1, so this is the cheap case (binomial_rounds is the deep one)
+ */
+template <typename D>
+long long sequential_unions(int n) {
+  D d(n);
+  for (int i = 0; i + 1 < n; ++i) d.uni(i, i + 1);
+  long long sum = 0;
+  for (int i = 0; i < n; ++i) sum += d.root(i);
+  return sum;
+}
+
+template <typename D>
+long long random_ops(int n) {
+  D d(n);
+  mt19937 gen(1);
+  uniform_int_distribution<> dis(0, n - 1);
+  long long sum = 0;
+  for (int q = 0; q < n; ++q) {
+    d.uni(dis(gen), dis(gen));
+    sum += d.root(dis(gen));
+  }
+  return sum;
+}
+}  // namespace
+
+TEST_CASE("dsuf layouts", "[!benchmark][dsuf]") {
+  const int n = 1 << 24;
+  using BySize64 = BasicDSUF<dsuf_index<int64_t>>;
+  using ByRank32 = BasicDSUF<dsuf_by_rank, dsuf_index<uint32_t>>;
+
+  BENCHMARK("binomial recursive") { return binomial_rounds<RecursiveDSUF>(n); };
+  BENCHMARK("binomial by size") { return binomial_rounds<DSUF>(n); };
+  BENCHMARK("binomial by size int64") { return binomial_rounds<BySize64>(n); };
+  BENCHMARK("binomial by rank uint32") { return binomial_rounds<ByRank32>(n); };
+
+  BENCHMARK("sequential recursive") {
+    return sequential_unions<RecursiveDSUF>(n);
+  };
+  BENCHMARK("sequential by size") { return sequential_unions<DSUF>(n); };
+  BENCHMARK("sequential by rank uint32") {
+    return sequential_unions<ByRank32>(n);
+  };
+
+  BENCHMARK("random recursive") { return random_ops<RecursiveDSUF>(n); };
+  BENCHMARK("random by size") { return random_ops<DSUF>(n); };
+  BENCHMARK("random by rank uint32") { return random_ops<ByRank32>(n); };
+}
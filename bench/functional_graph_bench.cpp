@@ -0,0 +1,38 @@
+#include <catch2/catch.hpp>
+
+#include "ds/graph.hpp"
+
+#include <random>
+
+using namespace std;
+using namespace P;
+
+/*
+ * Random function on 10^7 vertices: one giant component, cycles and tails
+ * of length ~sqrt(|V|)
+ */
+TEST_CASE("functional graph", "[!benchmark][graph]") {
+  const int n = 10'000'000, q = 1'000'000;
+  mt19937 gen;
+  uniform_int_distribution<> dis(0, n - 1);
+  FunctionalGraph g(n);
+  for (int v = 0; v < n; ++v) g[v] = dis(gen);
+  vector<pair<int, long long>> queries(q);
+  for (auto& [v, k] : queries) v = dis(gen), k = gen() % (1 << 20);
+
+  BENCHMARK("find_cycle") { return g.find_cycle().size(); };
+  BENCHMARK("cycles") { return g.cycles().len.size(); };
+  BENCHMARK("parallel_cycles 1 thread") {
+    return g.parallel_cycles(1).len.size();
+  };
+  BENCHMARK("parallel_cycles") { return g.parallel_cycles().len.size(); };
+  BENCHMARK("successors 10^9") { return g.successors(1e9)[0]; };
+
+  auto table = g.jump_table(1 << 20);
+  BENCHMARK("jump_table 2^20") { return g.jump_table(1 << 20).levels(); };
+  BENCHMARK("10^6 jumps") {
+    long long s = 0;
+    for (auto [v, k] : queries) s += table.jump(v, k);
+    return s;
+  };
+}
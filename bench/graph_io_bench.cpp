@@ -0,0 +1,57 @@
+#include <catch2/catch.hpp>
+
+#include "ds/graph_io.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+using namespace std;
+using namespace P;
+namespace fs = std::filesystem;
+
+/*
+ * Text edge list of 10^6 vertices and 10^7 weighted edges (~170 MB)
+ *
+ * - ifstream: operator>> line by line into an AdjList
+ * - load_edge_list: mmap and parallel parsing
+ * - MappedCsrGraph: the same graph saved in the binary format, opened and
+ *   traversed once (sum of the weights) so every page is read
+ */
+TEST_CASE("graph loading", "[!benchmark][graph]") {
+  const int n = 1'000'000, m = 10'000'000;
+  auto txt = fs::temp_directory_path() / "pdsalgo_bench_edges.txt";
+  auto bin = fs::temp_directory_path() / "pdsalgo_bench_graph.bin";
+  {
+    mt19937 gen;
+    uniform_int_distribution<> dis(0, n - 1), wdis(1, 1000);
+    ofstream out(txt);
+    for (int q = 0; q < m; ++q)
+      out << dis(gen) << ' ' << dis(gen) << ' ' << wdis(gen) << '\n';
+  }
+  save_csr_graph(WeightedCsrGraph(load_edge_list<WeightedNode>(txt)), bin);
+
+  BENCHMARK("ifstream") {
+    ifstream in(txt);
+    WeightedAdjList al(n);
+    int u, v, w;
+    while (in >> u >> v >> w) al[u].push_back({v, w});
+    return al.N();
+  };
+  BENCHMARK("load_edge_list 1 thread") {
+    return load_edge_list<WeightedNode>(txt, 1).N();
+  };
+  BENCHMARK("load_edge_list") {
+    return load_edge_list<WeightedNode>(txt).N();
+  };
+  BENCHMARK("MappedCsrGraph") {
+    MappedCsrGraph<WeightedNode> g(bin);
+    long long s = 0;
+    for (int u = 0; u < g.N(); ++u)
+      for (auto [v, w] : g[u]) s += w;
+    return s;
+  };
+
+  fs::remove(txt);
+  fs::remove(bin);
+}
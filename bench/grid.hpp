@@ -0,0 +1,45 @@
+#ifndef BENCH_GRID_HPP
+#define BENCH_GRID_HPP
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "ds/csr_graph.hpp"
+
+namespace P {
+using namespace std;
+
+/*
+ * Edges (u, (v, w)) of a side x side grid, both ways; vertex y * side + x,
+ * weights in [minw, maxw]
+ *
+ * road: road-like, a quarter of the local edges missing plus every 16th row
+ * and column turned into a highway (weights in [1, 10])
+ */
+inline vector<pair<int, WeightedNode>> grid_edges(int side, int minw,
+                                                  int maxw, bool road = false) {
+  mt19937 gen(side);
+  uniform_int_distribution<> wdis(minw, maxw), fast(1, 10), keep(0, 3);
+  vector<pair<int, WeightedNode>> edges;
+  auto add = [&](int u, int v, bool highway) {
+    if (road && !highway && keep(gen) == 0) return;
+    int w = highway ? fast(gen) : wdis(gen);
+    edges.push_back({u, {v, w}});
+    edges.push_back({v, {u, w}});
+  };
+  for (int y = 0; y < side; ++y)
+    for (int x = 0; x < side; ++x) {
+      int u = y * side + x;
+      if (x + 1 < side) add(u, u + 1, road && y % 16 == 0);
+      if (y + 1 < side) add(u, u + side, road && x % 16 == 0);
+    }
+  return edges;
+}
+
+inline WeightedCsrGraph grid(int side, int minw, int maxw, bool road = false) {
+  return WeightedCsrGraph(side * side, grid_edges(side, minw, maxw, road));
+}
+
+}  // namespace P
+#endif /* BENCH_GRID_HPP */
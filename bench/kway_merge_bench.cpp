@@ -0,0 +1,48 @@
+#include <catch2/catch.hpp>
+
+#include "algo/kway_merge.hpp"
+
+#include <algorithm>
+#include <queue>
+#include <random>
+
+using namespace std;
+using namespace P;
+
+TEST_CASE("k-way merge", "[!benchmark][kway_merge]") {
+  const int n = 1 << 22;  // elements in total
+  mt19937 gen;
+  vector<int> out(n);
+
+  for (int k : {2, 4, 16, 64, 256, 1024}) {
+    vector<vector<int>> shards(k);
+    for (int q = 0; q < n; ++q) shards[gen() % k].push_back(gen());
+    for (auto& s : shards) sort(begin(s), end(s));
+
+    BENCHMARK("loser tree k = " + to_string(k)) {
+      return kway_merge(shards, begin(out)) - begin(out);
+    };
+    BENCHMARK("priority_queue k = " + to_string(k)) {
+      using E = pair<int, int>;  // head, shard
+      priority_queue<E, vector<E>, greater<E>> pq;
+      vector<size_t> pos(k);
+      for (int i = 0; i < k; ++i)
+        if (!shards[i].empty()) pq.push({shards[i][0], i});
+      auto it = begin(out);
+      while (!pq.empty()) {
+        auto [v, i] = pq.top();
+        pq.pop();
+        *it++ = v;
+        if (++pos[i] < shards[i].size()) pq.push({shards[i][pos[i]], i});
+      }
+      return it - begin(out);
+    };
+    if (k == 2) {
+      BENCHMARK("std::merge k = 2") {
+        return merge(begin(shards[0]), end(shards[0]), begin(shards[1]),
+                     end(shards[1]), begin(out)) -
+               begin(out);
+      };
+    }
+  }
+}
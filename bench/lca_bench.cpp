@@ -0,0 +1,63 @@
+#include <catch2/catch.hpp>
+
+#include "ds/graph.hpp"
+#include "ds/heavy_light.hpp"
+#include "ds/lca.hpp"
+
+#include <numeric>
+#include <random>
+
+using namespace std;
+using namespace P;
+
+/*
+ * Trees of 10^7 vertices under shuffled ids, 10^6 random queries:
+ * - random: parent of v uniform among the earlier vertices (height ~ log)
+ * - deep: parent of v is v - 1 with probability 0.9 (height ~ |V| / 10)
+ */
+TEST_CASE("lowest common ancestor", "[!benchmark][graph]") {
+  const int n = 10'000'000, q = 1'000'000;
+  const double chain = GENERATE(0.0, 0.9);
+  mt19937 gen;
+  vector<int> id(n);
+  iota(id.begin(), id.end(), 0);
+  shuffle(id.begin(), id.end(), gen);
+  bernoulli_distribution ext(chain);
+  AdjList al(n);
+  for (int v = 1; v < n; ++v) {
+    int p = ext(gen) ? v - 1 : uniform_int_distribution<>(0, v - 1)(gen);
+    al[id[p]].push_back(id[v]);
+  }
+  uniform_int_distribution<> dis(0, n - 1);
+  vector<pair<int, int>> queries(q);
+  for (auto& [u, v] : queries) u = dis(gen), v = dis(gen);
+  RootedTree t(al, id[0]);
+  auto run = [&queries](auto const& lca) {
+    long long s = 0;
+    for (auto [u, v] : queries) s += lca.lca(u, v);
+    return s;
+  };
+  string tree = chain == 0 ? "random tree " : "deep tree ";
+
+  BENCHMARK(tree + "RootedTree") { return RootedTree(al, id[0]).N(); };
+  {
+    EulerTourLca et(t);
+    BENCHMARK(tree + "EulerTourLca build") { return EulerTourLca(t).N(); };
+    BENCHMARK(tree + "EulerTourLca queries") { return run(et); };
+  }
+  {
+    BinaryLiftingLca bl(t);
+    BENCHMARK(tree + "BinaryLiftingLca build") {
+      return BinaryLiftingLca(t).N();
+    };
+    BENCHMARK(tree + "BinaryLiftingLca queries") { return run(bl); };
+  }
+  {
+    HeavyLight hl(t);
+    BENCHMARK(tree + "HeavyLight build") { return HeavyLight(t).N(); };
+    BENCHMARK(tree + "HeavyLight queries") { return run(hl); };
+  }
+  BENCHMARK(tree + "tarjan_lca") {
+    return tarjan_lca(al, id[0], queries).size();
+  };
+}
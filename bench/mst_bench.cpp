@@ -0,0 +1,33 @@
+#include <catch2/catch.hpp>
+
+#include "ds/csr_graph.hpp"
+
+#include <random>
+
+using namespace std;
+using namespace P;
+
+/*
+ * Random undirected graph: 10^6 vertices, 10^7 edges (stored both ways),
+ * weights in [0, 10^6]
+ *
+ * 10^8 edges would need about 6 GB for the AdjList, the CsrGraph and the
+ * edge arrays of kruskal and boruvka together, so the graph is 10x smaller
+ */
+TEST_CASE("minimum spanning forest", "[!benchmark][graph]") {
+  const int n = 1'000'000, m = 10'000'000;
+  mt19937 gen;
+  uniform_int_distribution<> dis(0, n - 1), wdis(0, 1'000'000);
+  WeightedAdjList al(n);
+  for (int q = 0; q < m; ++q) {
+    int u = dis(gen), v = dis(gen), w = wdis(gen);
+    al[u].push_back({v, w});
+    al[v].push_back({u, w});
+  }
+  WeightedCsrGraph g(al);
+
+  BENCHMARK("kruskal") { return g.kruskal().weight; };
+  BENCHMARK("prim") { return g.prim().weight; };
+  BENCHMARK("boruvka 1 thread") { return g.boruvka(1).weight; };
+  BENCHMARK("boruvka") { return g.boruvka().weight; };
+}
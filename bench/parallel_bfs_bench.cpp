@@ -0,0 +1,38 @@
+#include <catch2/catch.hpp>
+
+#include "ds/csr_graph.hpp"
+
+#include <random>
+
+using namespace std;
+using namespace P;
+
+/*
+ * Low-diameter random undirected graph: 4 * 10^6 vertices, 1.6 * 10^7 edges
+ * stored both ways, with a skewed (power-law-like) degree distribution
+ */
+TEST_CASE("parallel bfs", "[!benchmark][graph]") {
+  const int n = 4'000'000, m = 16'000'000;
+  mt19937 gen;
+  uniform_real_distribution<> dis(0, 1);
+  auto pick = [&] { return int(n * dis(gen) * dis(gen)); };  // skewed
+  vector<pair<int, Node>> edges;
+  edges.reserve(2 * m);
+  for (int q = 0; q < m; ++q) {
+    int u = pick(), v = pick();
+    edges.push_back({u, v});
+    edges.push_back({v, u});
+  }
+  CsrGraph g(n, edges);
+  edges = {};
+
+  BENCHMARK("bfs_depth") {
+    long long s = 0;
+    g.bfs_depth(0, [&s](Node, int d) { s += d; });
+    return s;
+  };
+  for (int nt = 1; nt <= num_threads(); nt *= 2)
+    BENCHMARK("parallel_bfs " + to_string(nt) + " threads") {
+      return g.parallel_bfs(0, nt);
+    };
+}
@@ -0,0 +1,44 @@
+#include <catch2/catch.hpp>
+
+#include "algo/quick_select.hpp"
+#include "algo/quick_sort.hpp"
+#include "algo/top_k.hpp"
+
+#include <algorithm>
+#include <random>
+
+using namespace std;
+using namespace P;
+
+TEST_CASE("k smallest in order", "[!benchmark][partial_sort]") {
+  const int n = 1 << 20;
+  mt19937 gen;
+  vector<int> input(n);
+  generate(begin(input), end(input), gen);
+
+  for (int k : {16, 1 << 10, n / 2}) {
+    auto run = [&](char const* name, auto f) {
+      BENCHMARK_ADVANCED(name + (" k = " + to_string(k)))
+      (Catch::Benchmark::Chronometer meter) {
+        vector<vector<int>> vs(meter.runs(), input);
+        meter.measure([&](int i) { return f(vs[i]); });
+      };
+    };
+    run("quick_select + quick_sort", [k](vector<int>& v) {
+      quick_select(v, k - 1);
+      quick_sort(v, 0, k - 1);
+      return v[0];
+    });
+    run("partial_quick_sort", [k](vector<int>& v) {
+      partial_quick_sort(v, k);
+      return v[0];
+    });
+    run("std::partial_sort", [k](vector<int>& v) {
+      partial_sort(begin(v), begin(v) + k, end(v));
+      return v[0];
+    });
+    BENCHMARK("TopK (streamed) k = " + to_string(k)) {
+      return top_k(begin(input), end(input), k).front();
+    };
+  }
+}
@@ -0,0 +1,45 @@
+#include <catch2/catch.hpp>
+
+#include "ds/graph.hpp"
+#include "grid.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace std;
+using namespace P;
+
+/*
+ * 1000 x 1000 grid, weights in [1, 100], under a random numbering: bfs and
+ * dijkstra from vertex 0 before and after relabeling by each ordering
+ */
+TEST_CASE("vertex reordering", "[!benchmark][graph]") {
+  const int k = 1000, n = k * k;
+  mt19937 gen;
+  vector<int> shuf(n);
+  iota(shuf.begin(), shuf.end(), 0);
+  shuffle(shuf.begin(), shuf.end(), gen);
+  WeightedAdjList al(n);
+  for (auto [u, e] : grid_edges(k, 1, 100))
+    al[shuf[u]].push_back({shuf[e.val], e.w});
+
+  auto run = [](string name, auto const& g, int root) {
+    BENCHMARK(name + " bfs") {
+      long long s = 0;
+      g.bfs(root, [&s](int u) { s += u; });
+      return s;
+    };
+    BENCHMARK(name + " dijkstra") { return g.dijkstra(root)[0]; };
+  };
+  run("random", al, shuf[0]);
+
+  vector<int> perm;
+  BENCHMARK("degree_order") { perm = al.degree_order(); };
+  run("degree", al.relabeled(perm), perm[shuf[0]]);
+  BENCHMARK("rcm_order") { perm = al.rcm_order(); };
+  run("rcm", al.relabeled(perm), perm[shuf[0]]);
+  BENCHMARK("community_order") { perm = al.community_order(); };
+  run("community", al.relabeled(perm), perm[shuf[0]]);
+  BENCHMARK("relabel") { return al.relabeled(perm).N(); };
+}
@@ -0,0 +1,43 @@
+#include <catch2/catch.hpp>
+
+#include "ds/csr_graph.hpp"
+
+#include <random>
+
+using namespace std;
+using namespace P;
+
+/*
+ * 2 * 10^6 vertices
+ * - giant: random graph of average degree 5, one component holds most of
+ *   the vertices
+ * - small: cycles of 8 vertices, linked only forward (u -> v with u < v,
+ *   across cycles), so 2.5 * 10^5 components of 8
+ */
+TEST_CASE("strongly connected components", "[!benchmark][graph]") {
+  const int n = 2'000'000, m = 10'000'000, k = 8;
+  mt19937 gen;
+  uniform_int_distribution<> dis(0, n - 1);
+  AdjList giant(n), small(n);
+  for (int q = 0; q < m; ++q) giant[dis(gen)].push_back(dis(gen));
+  for (int u = 0; u < n; ++u) {
+    small[u].push_back(u % k == k - 1 ? u - k + 1 : u + 1);
+    int a = dis(gen), b = dis(gen);
+    if (a / k != b / k) small[min(a, b)].push_back(max(a, b));
+  }
+  CsrGraph<> g(giant), s(small);
+
+  BENCHMARK("tarjan giant") {
+    return g.strongly_connected_components()[0];
+  };
+  BENCHMARK("parallel_scc giant 1 thread") { return g.parallel_scc(1)[0]; };
+  BENCHMARK("parallel_scc giant") { return g.parallel_scc()[0]; };
+  BENCHMARK("tarjan small") {
+    return s.strongly_connected_components()[0];
+  };
+  BENCHMARK("parallel_scc small 1 thread") { return s.parallel_scc(1)[0]; };
+  BENCHMARK("parallel_scc small") { return s.parallel_scc()[0]; };
+
+  auto comp = s.strongly_connected_components();
+  BENCHMARK("condense small") { return s.condense(comp).N(); };
+}
@@ -0,0 +1,47 @@
+#include <catch2/catch.hpp>
+
+#include "ds/csr_graph.hpp"
+#include "grid.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace P;
+
+namespace {
+// mean latency of random queries
+template <typename Query>
+void bench_queries(string const& name, int n, Query query) {
+  mt19937 gen(n);
+  uniform_int_distribution<> dis(0, n - 1);
+  BENCHMARK(name.c_str()) { return query(dis(gen), dis(gen)); };
+}
+}  // namespace
+
+TEST_CASE("point-to-point shortest paths", "[!benchmark][graph]") {
+  const int side = 1000;  // 10^6 vertices
+  for (bool road : {false, true}) {
+    auto g = grid(side, 1, 100, road);
+    auto rev = g.transpose();
+    const int n = g.N();
+    const string kind = road ? "road " : "grid ";
+    DijkstraWorkspace<> ws;
+    BidirectionalWorkspace bws;
+    AltHeuristic alt(g, rev, AltHeuristic::farthest_landmarks(g, 8));
+
+    bench_queries(kind + "dijkstra full", n, [&](int s, int t) {
+      g.dijkstra(ws, s);
+      return ws.dis[t];
+    });
+    bench_queries(kind + "dijkstra early exit", n, [&](int s, int t) {
+      return g.dijkstra(ws, s, t);
+    });
+    bench_queries(kind + "bidirectional", n, [&](int s, int t) {
+      return g.bidirectional_dijkstra(rev, bws, s, t);
+    });
+    bench_queries(kind + "astar alt", n, [&](int s, int t) {
+      return g.astar(ws, s, t, [&](int v) { return alt(v, t); });
+    });
+  }
+}
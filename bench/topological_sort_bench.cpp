@@ -0,0 +1,77 @@
+#include <catch2/catch.hpp>
+
+#include "ds/csr_graph.hpp"
+#include "ds/dynamic_topo_order.hpp"
+
+#include <random>
+
+using namespace std;
+using namespace P;
+
+/*
+ * Random DAG: 4 * 10^6 vertices, 2 * 10^7 edges u -> v with u < v
+ */
+TEST_CASE("topological levels", "[!benchmark][graph]") {
+  const int n = 4'000'000, m = 20'000'000;
+  mt19937 gen;
+  uniform_int_distribution<> dis(0, n - 1);
+  AdjList al(n);
+  for (int q = 0; q < m; ++q) {
+    int u = dis(gen), v = dis(gen);
+    if (u != v) al[min(u, v)].push_back(max(u, v));
+  }
+  CsrGraph<> g(al);
+
+  BENCHMARK("topological_sort") {
+    long long c = 0;
+    g.topological_sort([&c](Node x) { c ^= x; });
+    return c;
+  };
+  BENCHMARK("topological_levels 1 thread") {
+    return g.topological_levels(1).size();
+  };
+  BENCHMARK("topological_levels") { return g.topological_levels().size(); };
+}
+
+/*
+ * 10^4 random edge insertions into a DAG of 10^5 vertices, against
+ * recomputing the order after every insertion (on 10^2 insertions)
+ */
+TEST_CASE("dynamic topological order", "[!benchmark][graph]") {
+  const int n = 100'000, m = 300'000, k = 10'000;
+  mt19937 gen;
+  uniform_int_distribution<> dis(0, n - 1);
+  AdjList al(n);
+  for (int q = 0; q < m; ++q) {
+    int u = dis(gen), v = dis(gen);
+    if (u != v) al[min(u, v)].push_back(max(u, v));
+  }
+  vector<pair<int, int>> edges(k);
+  for (auto& [u, v] : edges) {
+    u = dis(gen);
+    v = dis(gen);
+  }
+
+  BENCHMARK("add_edge") {
+    DynamicTopoOrder t(al);
+    int added = 0;
+    for (auto [u, v] : edges) added += t.add_edge(u, v);
+    return added;
+  };
+  BENCHMARK("recompute") {
+    AdjList cur = al;
+    int added = 0;
+    for (int q = 0; q < 100; ++q) {
+      auto [u, v] = edges[q];
+      cur[u].push_back(v);
+      if (cur.is_cyclic()) {
+        cur[u].pop_back();
+        continue;
+      }
+      ++added;
+      long long c = 0;
+      cur.topological_sort([&c](Node x) { c ^= x; });
+    }
+    return added;
+  };
+}
@@ -1,10 +1,11 @@
 build_type="Debug"
 build_tests=""
 build_test_extra=""
+build_bench=""
 
 cmake_cxx_flags="-O0 -ggdb3 -Wall -Wsign-compare"
 third_party_dir=$(pwd)/third_party
-while getopts "rtp:" o; do
+while getopts "rtbp:" o; do
     case "${o}" in
         r) # release build
             build_type="Release"
@@ -14,6 +15,10 @@ while getopts "rtp:" o; do
             build_tests="-DBUILD_TESTS=ON"
             build_test_extra="-DCMAKE_INCLUDE_PATH:PATH=$third_party_dir/cxx-prettyprint"
             ;;
+        b)
+            build_bench="-DBUILD_BENCH=ON"
+            build_test_extra="-DCMAKE_INCLUDE_PATH:PATH=$third_party_dir/cxx-prettyprint"
+            ;;
         p)
             temp=${OPTARG}
             ;;
@@ -25,5 +30,5 @@ shift $((OPTIND-1))
 export CXX="clang++"
 export CC="clang"
 
-cmake -H. -Bpdsalgo_build -DCMAKE_INSTALL_PREFIX:PATH=install -DCMAKE_EXPORT_COMPILE_COMMANDS=ON -DCMAKE_BUILD_TYPE=$build_type $build_tests $build_test_extra -DCMAKE_CXX_FLAGS="$cmake_cxx_flags"
+cmake -H. -Bpdsalgo_build -DCMAKE_INSTALL_PREFIX:PATH=install -DCMAKE_EXPORT_COMPILE_COMMANDS=ON -DCMAKE_BUILD_TYPE=$build_type $build_tests $build_bench $build_test_extra -DCMAKE_CXX_FLAGS="$cmake_cxx_flags"
 cmake --build pdsalgo_build --config $build_type --target install -- -j 8
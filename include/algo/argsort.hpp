@@ -0,0 +1,137 @@
+#ifndef ARGSORT_HPP
+#define ARGSORT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "algo/counting_sort.hpp"
+#include "algo/quick_sort.hpp"
+#include "util/functional.hpp"
+
+/*
+ * Index sort (argsort) and key + payload sorts for struct-of-arrays data
+ *
+ * Only the key column is touched while sorting; payload columns are permuted
+ * once at the end by a gather
+ *
+ * Indices are uint32_t: ranges must hold fewer than 2^32 elements
+ */
+namespace P {
+using namespace std;
+
+/*
+ * Return perm s.t. proj(first[perm[0]]) <= proj(first[perm[1]]) <= ...
+ *
+ * Stable: equal keys keep their original order
+ *
+ * (key, index) pairs are sorted instead of indices with an indirect compare,
+ * so the sort scans contiguous memory; ties broken by index make the unstable
+ * quick_sort2 give a stable result
+ */
+template <typename It, typename Compare = less<>, typename Proj = identity>
+vector<uint32_t> argsort(It first, It last, Compare comp = {},
+                         Proj proj = {}) {
+  using K = decay_t<invoke_result_t<Proj, decltype(*first)>>;
+  const size_t n = last - first;
+  vector<pair<K, uint32_t>> kv(n);
+  for (size_t q = 0; q < n; ++q)
+    kv[q] = {invoke(proj, first[q]), uint32_t(q)};
+  quick_sort2(begin(kv), end(kv), [&comp](auto const& a, auto const& b) {
+    if (invoke(comp, a.first, b.first)) return true;
+    if (invoke(comp, b.first, a.first)) return false;
+    return a.second < b.second;
+  });
+  vector<uint32_t> perm(n);
+  for (size_t q = 0; q < n; ++q) perm[q] = kv[q].second;
+  return perm;
+}
+
+template <typename T>
+vector<uint32_t> argsort(vector<T> const& v) {
+  return argsort(begin(v), end(v));
+}
+
+/*
+ * Stable argsort by a small unsigned key f(e) < S, see counting_sort
+ *
+ * Time complexity: O(n + S)
+ */
+template <typename It, typename Func,
+          typename T = typename iterator_traits<It>::value_type,
+          size_t S = size_t(1) << (sizeof(invoke_result_t<Func, T>) * 8)>
+vector<uint32_t> counting_argsort(It first, It last, Func f) {
+  const size_t n = last - first;
+  auto c = make_counts<S, uint32_t>();
+  for (size_t q = 0; q < n; ++q) ++c[invoke(f, first[q])];
+  exclusive_scan(begin(c), end(c), begin(c), uint32_t(0));
+  vector<uint32_t> perm(n);
+  for (size_t q = 0; q < n; ++q) perm[c[invoke(f, first[q])]++] = q;
+  return perm;
+}
+
+/*
+ * out[q] = src[perm[q]] for q in [0, perm.size())
+ */
+template <typename RandIt, typename OutIt>
+OutIt gather(vector<uint32_t> const& perm, RandIt src, OutIt out) {
+  for (auto i : perm) *out++ = src[i];
+  return out;
+}
+
+// index of the first Ts that is T
+template <typename T, typename... Ts>
+constexpr size_t first_type_index() {
+  size_t i = 0;
+  (void)((!is_same_v<T, Ts> && ++i) && ...);
+  return i;
+}
+
+/*
+ * Permute every column in place: col[q] <- old col[perm[q]]
+ *
+ * The columns are gathered one after the other into a scratch buffer that
+ * is then swapped with the column, so the buffer left holds the old column
+ * and is reused by the next column of the same type: the extra memory is
+ * one column per element type, not a copy of the whole table. perm is read
+ * in blocks of BlockSize indices.
+ */
+template <size_t BlockSize = 4096, typename... Ts>
+void apply_permutation(vector<uint32_t> const& perm, vector<Ts>&... cols) {
+  const size_t n = perm.size();
+  tuple<vector<Ts>...> scratch;  // only the first of each type is used
+  auto permute = [&](auto& col) {
+    using T = typename decay_t<decltype(col)>::value_type;
+    auto& tmp = get<first_type_index<T, Ts...>()>(scratch);
+    tmp.resize(n);
+    for (size_t lo = 0; lo < n; lo += BlockSize) {
+      const size_t hi = min(n, lo + BlockSize);
+      for (size_t q = lo; q < hi; ++q) tmp[q] = move(col[perm[q]]);
+    }
+    swap(tmp, col);
+  };
+  (permute(cols), ...);
+}
+
+/*
+ * Sort keys ascending and permute the payload columns accordingly
+ * (struct of arrays)
+ *
+ * Stable; every payload column is read and written exactly once
+ * For a custom order, use argsort + apply_permutation
+ */
+template <typename K, typename... Ts>
+vector<uint32_t> sort_by_key(vector<K>& keys, vector<Ts>&... payloads) {
+  auto perm = argsort(begin(keys), end(keys));
+  apply_permutation(perm, keys, payloads...);
+  return perm;
+}
+
+}  // namespace P
+#endif /* ARGSORT_HPP */
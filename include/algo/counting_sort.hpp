@@ -4,18 +4,47 @@
 #include <algorithm>
 #include <array>
 #include <functional>
+#include <iterator>
 #include <numeric>
+#include <type_traits>
 #include <vector>
 
 namespace P {
 using namespace std;
 
+// zeroed counts of S keys; on the heap when S is too large for the stack
+template <size_t S, typename C = size_t>
+auto make_counts() {
+  constexpr size_t StackLimit = 1 << 10;
+  if constexpr (S <= StackLimit)
+    return array<C, S>{};
+  else
+    return vector<C>(S);
+}
+
+template <typename It, typename T = typename iterator_traits<It>::value_type,
+          size_t S = size_t(1) << (sizeof(T) * 8)>
+void counting_sort_inplace(It first, It last) {
+  auto c = make_counts<S>();
+  for (auto it = first; it != last; ++it) ++c[*it];
+  for (size_t q = 0; q < c.size(); ++q) first = fill_n(first, c[q], T(q));
+}
+
 template <typename T, int S = 1 << (sizeof(T) * 8)>
 void counting_sort_inplace(vector<T>& v) {
-  array<int, S> c{};
-  for (auto const& e : v) ++c[e];
-  auto it = begin(v);
-  for (int q = 0; q < (int)c.size(); ++q) it = fill_n(it, c[q], q);
+  counting_sort_inplace<typename vector<T>::iterator, T, S>(begin(v), end(v));
+}
+
+// stable sort [first, last) based on f(e) into out
+// f is the projection to an unsigned key smaller than S
+template <typename It, typename OutIt, typename Func,
+          typename T = typename iterator_traits<It>::value_type,
+          size_t S = size_t(1) << (sizeof(invoke_result_t<Func, T>) * 8)>
+void counting_sort(It first, It last, OutIt out, Func f) {
+  auto c = make_counts<S>();
+  for (auto it = first; it != last; ++it) ++c[invoke(f, *it)];
+  exclusive_scan(begin(c), end(c), begin(c), size_t(0));
+  for (auto it = first; it != last; ++it) out[c[invoke(f, *it)]++] = *it;
 }
 
 // stable sort the collection based on f(e) for e in v
@@ -24,19 +53,17 @@ void counting_sort_inplace(vector<T>& v) {
 template <typename T, typename Func,
           int S = 1 << (sizeof(result_of_t<Func(T)>) * 8)>
 vector<T> counting_sort(const vector<T>& v, Func f) {
-  array<int, S> c{};
-  for (auto const& e : v) ++c[f(e)];
-  partial_sum(begin(c), end(c), begin(c));
   vector<T> res(v.size());
-  for (int q = v.size() - 1; q >= 0 && q < (int)v.size(); --q)
-    res[--c[f(v[q])]] = v[q];
+  counting_sort<typename vector<T>::const_iterator,
+                typename vector<T>::iterator, Func, T, S>(begin(v), end(v),
+                                                          begin(res), f);
   return res;
 }
 
 template <typename T, typename Func,
           int S = 1 << (sizeof(result_of_t<Func(T)>) * 8)>
 vector<T> counting_sort2(const vector<T>& v, Func f) {
-  array<int, S> c{};
+  auto c = make_counts<S, int>();
   for (auto const& e : v) ++c[f(e)];
   for (int q = 0, sum = 0; q < S; ++q) {
     int t = c[q];
@@ -0,0 +1,236 @@
+#ifndef EXTERNAL_SORT_HPP
+#define EXTERNAL_SORT_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "algo/loser_tree.hpp"
+#include "algo/sort.hpp"
+#include "util/file.hpp"
+
+/*
+ * External-memory merge sort of fixed-width records (POSIX)
+ *
+ * 1. Run generation: read memory_budget bytes of records at a time, sort them
+ *    in memory with sort_range and write each sorted run to a temp file
+ * 2. Merge: k-way merge the runs with a LoserTree. Every run is read through
+ *    a double-buffered BlockReader (the next block is read asynchronously
+ *    while the current one is consumed) and the output goes through a
+ *    double-buffered BlockWriter. If the budget cannot hold two blocks per
+ *    run, groups of runs are merged into longer runs first (multi-pass)
+ *
+ * Temp files are unlinked right after creation, so they disappear with their
+ * descriptors even if the sort throws.
+ *
+ * Errors (I/O failure, input size not a multiple of sizeof(E)) are reported
+ * by throwing system_error / invalid_argument
+ */
+namespace P {
+using namespace std;
+
+struct ExternalSortConfig {
+  size_t memory_budget = size_t(256) << 20;  // bytes, run length in phase 1
+  size_t block_size = size_t(1) << 20;       // bytes per read/write request
+  string temp_dir = "/tmp";
+  bool unique = false;  // drop records equal to the previous output record
+};
+
+/*
+ * Sequential reader with one block in use and one block in flight
+ */
+template <typename E>
+class BlockReader {
+ public:
+  BlockReader(FILE* f, size_t block_recs)
+      : f(f), cur(block_recs), next(block_recs) {
+    fetch();
+    swap_in();
+  }
+
+  bool empty() const { return pos == len; }
+  E const& front() const { return cur[pos]; }
+  void pop() {
+    if (++pos == len) swap_in();
+  }
+
+ private:
+  void fetch() {
+    auto read_block = [f = f, buf = next.data(), n = next.size()] {
+      size_t r = fread(buf, sizeof(E), n, f);
+      if (r < n && ferror(f))
+        throw system_error(errno, generic_category(), "read run");
+      return r;
+    };
+    pending = async(launch::async, read_block);
+  }
+
+  void swap_in() {
+    pos = 0;
+    len = pending.valid() ? pending.get() : 0;
+    swap(cur, next);
+    if (len == cur.size()) fetch();  // a short read means end of file
+  }
+
+  FILE* f;
+  vector<E> cur, next;
+  size_t pos = 0, len = 0;
+  future<size_t> pending;
+};
+
+/*
+ * Sequential writer: fills one block while the previous one is written
+ */
+template <typename E>
+class BlockWriter {
+ public:
+  BlockWriter(FILE* f, size_t block_recs) : f(f), cap(block_recs) {
+    cur.reserve(cap);
+    next.reserve(cap);
+  }
+  ~BlockWriter() {
+    if (pending.valid()) pending.wait();
+  }
+
+  void push(E const& e) {
+    cur.push_back(e);
+    if (cur.size() == cap) flush();
+  }
+
+  // write everything pushed so far, rethrowing any write error
+  void finish() {
+    flush();
+    wait();
+    if (fflush(f)) throw system_error(errno, generic_category(), "flush");
+  }
+
+ private:
+  void wait() {
+    if (pending.valid()) pending.get();
+  }
+
+  void flush() {
+    wait();
+    swap(cur, next);
+    cur.clear();
+    if (next.empty()) return;
+    auto write_block = [f = f, buf = next.data(), n = next.size()] {
+      if (fwrite(buf, sizeof(E), n, f) != n)
+        throw system_error(errno, generic_category(), "write");
+    };
+    pending = async(launch::async, write_block);
+  }
+
+  FILE* f;
+  size_t cap;
+  vector<E> cur, next;
+  future<void> pending;
+};
+
+/*
+ * k-way merge of the sorted runs (read from the start) into out
+ */
+template <typename E, typename Compare>
+void merge_runs(vector<FilePtr> const& runs, FILE* out, size_t block_recs,
+                Compare comp, bool unique) {
+  const int k = runs.size();
+  vector<unique_ptr<BlockReader<E>>> rd;
+  LoserTree<E, Compare> lt(k, comp);
+  for (int i = 0; i < k; ++i) {
+    rewind(runs[i].get());
+    rd.push_back(make_unique<BlockReader<E>>(runs[i].get(), block_recs));
+    if (rd[i]->empty())
+      lt.set_exhausted(i);
+    else
+      lt.set(i, rd[i]->front());
+  }
+  lt.build();
+
+  BlockWriter<E> w(out, block_recs);
+  E last{};
+  bool has_last = false;
+  while (!lt.empty()) {
+    int i = lt.winner();
+    E const& e = lt.winner_key();
+    if (!unique || !has_last || comp(last, e)) {
+      w.push(e);
+      last = e;
+      has_last = true;
+    }
+    rd[i]->pop();
+    if (rd[i]->empty())
+      lt.pop();
+    else
+      lt.replace(rd[i]->front());
+  }
+  w.finish();
+}
+
+/*
+ * Sort the records of type E in in_path into out_path (in_path may equal
+ * out_path)
+ *
+ * Time complexity: O(n log n) comparisons, O(n/B * passes) block I/Os with
+ * passes = 1 + ceil(log_F(runs)) and F = fan-in allowed by the budget
+ * Extra space: memory_budget bytes of RAM, n * sizeof(E) bytes of temp files
+ *
+ * Unstable
+ */
+template <typename E, typename Compare = less<>>
+void external_sort(string const& in_path, string const& out_path,
+                   ExternalSortConfig const& cfg = {}, Compare comp = {}) {
+  static_assert(is_trivially_copyable_v<E>, "fixed-width records only");
+  const size_t run_recs = max<size_t>(1, cfg.memory_budget / sizeof(E));
+  const size_t block_recs = max<size_t>(1, cfg.block_size / sizeof(E));
+  // two blocks per input run plus two for the output
+  const size_t block_pairs = cfg.memory_budget / (2 * block_recs * sizeof(E));
+  const size_t fan_in = max<size_t>(2, block_pairs ? block_pairs - 1 : 0);
+
+  vector<FilePtr> runs;
+  {
+    auto in = open_file(in_path, "rb");
+    vector<E> buf(run_recs);
+    while (true) {
+      size_t n = fread(buf.data(), 1, run_recs * sizeof(E), in.get());
+      if (ferror(in.get()))
+        throw system_error(errno, generic_category(), "read " + in_path);
+      if (n % sizeof(E))
+        throw invalid_argument(in_path + ": size not a multiple of record");
+      n /= sizeof(E);
+      if (n == 0) break;
+      sort_range(begin(buf), begin(buf) + n, comp);
+      runs.push_back(make_temp_file(cfg.temp_dir));
+      BlockWriter<E> w(runs.back().get(), block_recs);
+      for (size_t q = 0; q < n; ++q) w.push(buf[q]);
+      w.finish();
+      if (n < run_recs) break;
+    }
+  }
+
+  while (runs.size() > fan_in) {  // intermediate passes
+    vector<FilePtr> merged;
+    for (size_t lo = 0; lo < runs.size(); lo += fan_in) {
+      vector<FilePtr> group;
+      for (size_t q = lo; q < min(runs.size(), lo + fan_in); ++q)
+        group.push_back(move(runs[q]));
+      merged.push_back(make_temp_file(cfg.temp_dir));
+      merge_runs<E>(group, merged.back().get(), block_recs, comp, cfg.unique);
+    }
+    runs = move(merged);
+  }
+
+  auto out = open_file(out_path, "wb");
+  merge_runs<E>(runs, out.get(), block_recs, comp, cfg.unique);
+}
+
+}  // namespace P
+#endif /* EXTERNAL_SORT_HPP */
@@ -0,0 +1,106 @@
+#ifndef LOSER_TREE_HPP
+#define LOSER_TREE_HPP
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace P {
+using namespace std;
+
+/*
+ * Loser tree (tournament tree) over k sequences for k-way merging
+ *
+ * Every node caches the key of the sequence head it holds, so replaying a
+ * match walks one root-to-leaf path of contiguous nodes and never touches the
+ * inputs. Internal node n in [1, k) stores the loser of the match played
+ * there, node 0 the overall winner. Leaf i sits at position i + k, so any k
+ * works (no padding to a power of 2).
+ *
+ * Ties are won by the lower sequence index, which makes merges stable.
+ * Exhausted sequences lose against everything.
+ *
+ * Time complexity:
+ * - build: O(k)
+ * - replace / pop: O(log k), one match per level
+ */
+template <typename K, typename Compare = less<>>
+class LoserTree {
+ public:
+  LoserTree(int k, Compare comp = Compare())
+      : k(k), leaves(k), tree(max(k, 1)), comp(comp) {
+    for (int i = 0; i < k; ++i) leaves[i] = {K(), i, true};
+  }
+
+  // set the initial head of sequence i (before build)
+  void set(int i, K key) { leaves[i] = {move(key), i, false}; }
+  void set_exhausted(int i) { leaves[i].done = true; }
+
+  void build() {
+    live = 0;
+    if (k == 0) return;
+    vector<Node> win(2 * k);
+    for (int i = 0; i < k; ++i) {
+      live += !leaves[i].done;
+      win[i + k] = move(leaves[i]);
+    }
+    for (int n = k - 1; n >= 1; --n) {
+      auto& a = win[2 * n];
+      auto& b = win[2 * n + 1];
+      if (beats(a, b))
+        win[n] = move(a), tree[n] = move(b);
+      else
+        win[n] = move(b), tree[n] = move(a);
+    }
+    tree[0] = move(win[1]);
+    leaves = {};
+  }
+
+  bool empty() const { return live == 0; }
+  int winner() const { return tree[0].src; }
+  K const& winner_key() const { return tree[0].key; }
+
+  // the winning sequence advanced to its next key
+  void replace(K key) {
+    tree[0].key = move(key);
+    replay();
+  }
+
+  // the winning sequence ran out
+  void pop() {
+    tree[0].done = true;
+    --live;
+    replay();
+  }
+
+ private:
+  struct Node {
+    K key;
+    int src;    // sequence index
+    bool done;  // sequence exhausted
+  };
+
+  bool beats(Node const& a, Node const& b) const {
+    if (a.done || b.done) return !a.done || (b.done && a.src < b.src);
+    if (comp(a.key, b.key)) return true;
+    return !comp(b.key, a.key) && a.src < b.src;
+  }
+
+  // tree[0] changed: play it up from its leaf
+  void replay() {
+    Node c = move(tree[0]);
+    for (int n = (c.src + k) / 2; n >= 1; n /= 2)
+      if (beats(tree[n], c)) swap(tree[n], c);
+    tree[0] = move(c);
+  }
+
+  int k;
+  vector<Node> leaves;  // initial heads, only used until build
+  vector<Node> tree;    // [0]: winner, [1, k): losers
+  int live = 0;
+  Compare comp;
+};
+
+}  // namespace P
+#endif /* LOSER_TREE_HPP */
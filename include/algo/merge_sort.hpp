@@ -1,38 +1,73 @@
 #ifndef MERGE_SORT_HPP
 #define MERGE_SORT_HPP
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <vector>
 
+#include "util/functional.hpp"
+
 namespace P {
 using namespace std;
 
+/*
+ * Merge two sorted ranges [first, mid) and [mid, last) through buf
+ *
+ * buf needs room for (last - first) elements
+ * Stable: on ties the element from [first, mid) goes first
+ */
+template <typename It, typename Buf, typename Compare = less<>,
+          typename Proj = identity>
+void merge_adjacent(It first, It mid, It last, Buf buf, Compare comp = {},
+                    Proj proj = {}) {
+  auto a = first, b = mid;
+  auto e = buf;
+  while (a != mid && b != last) {
+    if (invoke(comp, invoke(proj, *b), invoke(proj, *a)))
+      *e++ = move(*b++);
+    else
+      *e++ = move(*a++);
+  }
+  e = move(a, mid, e);
+  e = move(b, last, e);
+  move(buf, e, first);
+}
+
 /*
  * Merge two sorted ranges [p, q] and [q + 1, r]
  */
 template <typename E>
 void merge(vector<E>& v, int p, int q, int r) {
-  auto len = r - p + 1;
-  vector<E> temp(len);
-  for (int e = 0, a = p, b = q + 1; e < len; ++e) {
-    if (a > q)
-      temp[e] = v[b++];
-    else if (b > r)
-      temp[e] = v[a++];
-    else if (v[a] <= v[b])
-      temp[e] = v[a++];
-    else
-      temp[e] = v[b++];
-  }
-  copy(begin(temp), end(temp), begin(v) + p);
+  vector<E> temp(r - p + 1);
+  merge_adjacent(begin(v) + p, begin(v) + q + 1, begin(v) + r + 1,
+                 begin(temp));
+}
+
+/*
+ * Stable sort [first, last) by comp(proj(a), proj(b))
+ *
+ * A single buffer of (last - first) elements is shared by all the merges
+ */
+template <typename It, typename Compare = less<>, typename Proj = identity>
+void merge_sort(It first, It last, Compare comp = {}, Proj proj = {}) {
+  using E = typename iterator_traits<It>::value_type;
+  vector<E> buf(last - first);
+  auto sort_ = [&comp, &proj](It lo, It hi, auto buf_it,
+                              auto sort__) -> void {
+    if (hi - lo < 2) return;
+    auto mid = lo + (hi - lo) / 2;
+    sort__(lo, mid, buf_it, sort__);
+    sort__(mid, hi, buf_it + (mid - lo), sort__);
+    merge_adjacent(lo, mid, hi, buf_it, comp, proj);
+  };
+  sort_(first, last, begin(buf), sort_);
 }
 
 template <typename E>
 void merge_sort(vector<E>& v, int lo, int hi) {
   if (lo >= hi) return;
-  int mid = (lo + hi) / 2;
-  merge_sort(v, lo, mid);
-  merge_sort(v, mid + 1, hi);
-  merge(v, lo, mid, hi);
+  merge_sort(begin(v) + lo, begin(v) + hi + 1);
 }
 
 template <typename E>
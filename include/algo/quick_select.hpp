@@ -2,11 +2,23 @@
 #define QUICK_SELECT_HPP
 
 #include <algorithm>
+#include <functional>
+#include <iterator>
 #include <vector>
 
+#include "util/functional.hpp"
+
 namespace P {
 using namespace std;
 
+/*
+ * The iterator versions work on [first, last) of any random access range
+ * (vector, deque, raw arrays...) and order elements by
+ * comp(proj(a), proj(b)); comp defaults to operator< and proj to identity
+ *
+ * The vector<E>& versions with int indices [lo, hi] forward to them
+ */
+
 /*
  * Lomuto partition scheme
  *
@@ -19,14 +31,23 @@ using namespace std;
  * pivot is preserved
  *
  * return position of the pivot
+ *
+ * The iterator version works on [first, last) and returns the iterator to
+ * the pivot
  */
+template <typename It, typename Compare = less<>, typename Proj = identity>
+It partition_lomuto(It first, It last, Compare comp = {}, Proj proj = {}) {
+  auto hi = last - 1;
+  auto const& pivot = invoke(proj, *hi);  // *hi stays put until the end
+  for (auto q = first; q < hi; ++q)
+    if (invoke(comp, invoke(proj, *q), pivot)) iter_swap(q, first++);
+  iter_swap(hi, first);
+  return first;
+}
+
 template <typename E = int>
 int partition_lomuto(vector<E> &v, int lo, int hi) {
-  auto pivot = v[hi];
-  for (int q = lo; q < hi; ++q)
-    if (v[q] < pivot) swap(v[q], v[lo++]);
-  swap(v[hi], v[lo]);
-  return lo;
+  return partition_lomuto(begin(v) + lo, begin(v) + hi + 1) - begin(v);
 }
 
 template <typename E = int>
@@ -48,41 +69,77 @@ int partition_lomuto(vector<E> &v) {
  * <= the pivot chosen originally (v[lo] this case)
  *
  * Important: Pivot uses v[lo] so that returned value < hi
+ *
+ * The iterator version works on [first, last) and returns it s.t.
+ * [first, it] <= pivot and (it, last) >= pivot, with first <= it < last - 1
  */
-template <typename E = int>
-int partition_hoare(vector<E> &v, int lo, int hi) {
-  auto pivot = v[lo];
-  --lo;
-  ++hi;
+template <typename It, typename Compare = less<>, typename Proj = identity>
+It partition_hoare(It first, It last, Compare comp = {}, Proj proj = {}) {
+  auto pivot = invoke(proj, *first);  // copy of the key only
+  // never form first - 1: the left scan starts on the pivot slot itself
   while (true) {
-    while (v[++lo] < pivot)
-      ;
-    while (v[--hi] > pivot)
-      ;
-    if (lo < hi)
-      swap(v[lo], v[hi]);
-    else
-      return hi;
+    while (invoke(comp, invoke(proj, *first), pivot)) ++first;
+    do
+      --last;
+    while (invoke(comp, pivot, invoke(proj, *last)));
+    if (first >= last) return last;
+    iter_swap(first++, last);
   }
 }
+
+template <typename E = int>
+int partition_hoare(vector<E> &v, int lo, int hi) {
+  return partition_hoare(begin(v) + lo, begin(v) + hi + 1) - begin(v);
+}
 template <typename E = int>
 int partition_hoare(vector<E> &v) {
   return partition_hoare(v, 0, (int)v.size() - 1);
 }
 
+/*
+ * Move the median of *a, *b, *c to *a
+ *
+ * Used before partition_hoare to avoid the O(n^2) case on sorted input
+ */
+template <typename It, typename Compare = less<>, typename Proj = identity>
+void move_median_to_first(It a, It b, It c, Compare comp = {},
+                          Proj proj = {}) {
+  auto lt = make_proj_compare(comp, proj);
+  if (lt(*b, *a)) iter_swap(a, b);
+  if (lt(*c, *b)) iter_swap(b, c);
+  if (lt(*b, *a)) iter_swap(a, b);
+  iter_swap(a, b);
+}
+
+/*
+ * Select the kth smallest element of [first, last) with partition_lomuto
+ * k is 0-indexed
+ *
+ * Return the iterator to it; the range is partitioned around it
+ */
+template <typename It, typename Compare = less<>, typename Proj = identity>
+It quick_select(It first, It last,
+                typename iterator_traits<It>::difference_type k,
+                Compare comp = {}, Proj proj = {}) {
+  auto nth = first + k;
+  while (last - first > 1) {
+    auto p = partition_lomuto(first, last, comp, proj);
+    if (p == nth) return p;
+    if (nth < p)
+      last = p;
+    else
+      first = p + 1;
+  }
+  return nth;
+}
+
 /*
  * Select the kth smallest element from v
  * k is 0-indexed
  */
 template <typename E = int>
 E quick_select(vector<E> &v, int k, int lo, int hi) {
-  if (lo == hi) return v[lo];
-  auto p = partition_lomuto(v, lo, hi);
-  if (p - lo == k) return v[p];
-  if (k < p - lo)
-    return quick_select(v, k, lo, p - 1);
-  else
-    return quick_select(v, k - (p - lo) - 1, p + 1, hi);
+  return *quick_select(begin(v) + lo, begin(v) + hi + 1, k);
 }
 
 template <typename E = int>
@@ -90,14 +147,35 @@ E quick_select(vector<E> &v, int k) {
   return quick_select(v, k, 0, (int)v.size() - 1);
 }
 
+/*
+ * nth_element-style selection on [first, last)
+ *
+ * After the call, *nth is the element that would be there if the range were
+ * sorted, [first, nth) <= *nth and (nth, last) >= *nth
+ *
+ * Iterative: each round keeps only the side of partition_hoare containing nth
+ * Time complexity: O(n) expected
+ */
+template <typename It, typename Compare = less<>, typename Proj = identity>
+void quick_nth(It first, It nth, It last, Compare comp = {}, Proj proj = {}) {
+  while (last - first > 2) {
+    move_median_to_first(first, first + (last - first) / 2, last - 1, comp,
+                         proj);
+    auto p = partition_hoare(first, last, comp, proj);
+    if (nth <= p)
+      last = p + 1;
+    else
+      first = p + 1;
+  }
+  if (last - first == 2 &&
+      invoke(comp, invoke(proj, *(first + 1)), invoke(proj, *first)))
+    iter_swap(first, first + 1);
+}
+
 template <typename E = int>
 E quick_select2(vector<E> &v, int k, int lo, int hi) {
-  if (lo == hi) return v[lo];
-  auto p = partition_hoare(v, lo, hi);
-  if (p - lo >= k)
-    return quick_select2(v, k, lo, p);
-  else
-    return quick_select2(v, k - (p - lo) - 1, p + 1, hi);
+  quick_nth(begin(v) + lo, begin(v) + lo + k, begin(v) + hi + 1);
+  return v[lo + k];
 }
 
 template <typename E = int>
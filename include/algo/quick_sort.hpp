@@ -1,19 +1,44 @@
 #ifndef QUICK_SORT_HPP
 #define QUICK_SORT_HPP
 
+#include <algorithm>
+#include <functional>
 #include <vector>
 
 #include "algo/quick_select.hpp"
+#include "util/functional.hpp"
 
 namespace P {
 using namespace std;
 
+/*
+ * Iterator versions sort [first, last) by comp(proj(a), proj(b))
+ *
+ * Recurse into the smaller partition and loop on the larger one so the stack
+ * depth is O(log n) even when the partitions are unbalanced
+ *
+ * Unstable; see merge_sort for the stable counterpart
+ *
+ * quick_sort2 takes the median of three as the Hoare pivot
+ */
+template <typename It, typename Compare = less<>, typename Proj = identity>
+void quick_sort(It first, It last, Compare comp = {}, Proj proj = {}) {
+  while (last - first > 1) {
+    auto p = partition_lomuto(first, last, comp, proj);
+    if (p - first < last - p) {
+      quick_sort(first, p, comp, proj);
+      first = p + 1;
+    } else {
+      quick_sort(p + 1, last, comp, proj);
+      last = p;
+    }
+  }
+}
+
 template <typename E>
 void quick_sort(vector<E>& v, int lo, int hi) {
   if (lo >= hi) return;
-  auto p = partition_lomuto(v, lo, hi);
-  quick_sort(v, lo, p - 1);
-  quick_sort(v, p + 1, hi);
+  quick_sort(begin(v) + lo, begin(v) + hi + 1);
 }
 
 template <typename E>
@@ -21,12 +46,27 @@ void quick_sort(vector<E>& v) {
   quick_sort(v, 0, v.size() - 1);
 }
 
+template <typename It, typename Compare = less<>, typename Proj = identity>
+void quick_sort2(It first, It last, Compare comp = {}, Proj proj = {}) {
+  while (last - first > 1) {
+    if (last - first > 2)
+      move_median_to_first(first, first + (last - first) / 2, last - 1, comp,
+                           proj);
+    auto p = partition_hoare(first, last, comp, proj) + 1;
+    if (p - first < last - p) {
+      quick_sort2(first, p, comp, proj);
+      first = p;
+    } else {
+      quick_sort2(p, last, comp, proj);
+      last = p;
+    }
+  }
+}
+
 template <typename E>
 void quick_sort2(vector<E>& v, int lo, int hi) {
   if (lo >= hi) return;
-  auto p = partition_hoare(v, lo, hi);
-  quick_sort2(v, lo, p);
-  quick_sort2(v, p + 1, hi);
+  quick_sort2(begin(v) + lo, begin(v) + hi + 1);
 }
 
 template <typename E>
@@ -34,6 +74,41 @@ void quick_sort2(vector<E>& v) {
   quick_sort2(v, 0, v.size() - 1);
 }
 
+/*
+ * Sort [first, middle) to hold the (middle - first) smallest elements of
+ * [first, last) in order; the order of [middle, last) is unspecified
+ *
+ * A partition entirely on or after middle is never visited, so this is
+ * O(n + k log k) expected instead of quick_select followed by quick_sort.
+ * As in quick_sort2, only the smaller partition is recursed into.
+ */
+template <typename It, typename Compare = less<>, typename Proj = identity>
+void partial_quick_sort(It first, It middle, It last, Compare comp = {},
+                        Proj proj = {}) {
+  while (last - first > 1 && first < middle) {
+    move_median_to_first(first, first + (last - first) / 2, last - 1, comp,
+                         proj);
+    auto p = partition_hoare(first, last, comp, proj) + 1;
+    if (middle <= p) {  // nothing to sort in [p, last)
+      last = p;
+    } else if (p - first < last - p) {
+      partial_quick_sort(first, middle, p, comp, proj);
+      first = p;
+    } else {
+      partial_quick_sort(p, middle, last, comp, proj);
+      last = p;
+    }
+  }
+}
+
+/*
+ * Sort the k smallest elements of v into v[0:k]
+ */
+template <typename E>
+void partial_quick_sort(vector<E>& v, int k) {
+  partial_quick_sort(begin(v), begin(v) + min(k, (int)v.size()), end(v));
+}
+
 }  // namespace P
 
 #endif /* QUICK_SORT_HPP */
@@ -0,0 +1,40 @@
+#ifndef SORT_HPP
+#define SORT_HPP
+
+#include <functional>
+
+#include "algo/merge_sort.hpp"
+#include "algo/quick_sort.hpp"
+#include "util/functional.hpp"
+
+namespace P {
+using namespace std;
+
+/*
+ * Sort [first, last) by comp(proj(a), proj(b)), picking the algorithm by tag
+ *
+ * stable_tag:   merge_sort, O(n) extra space
+ * unstable_tag: quick_sort2 (Hoare partition, median of three), in place
+ *
+ * Works on any random access range (vector, deque, arena-backed arrays...)
+ * without copying in and out of a vector
+ */
+template <typename It, typename Compare = less<>, typename Proj = identity>
+void sort_range(stable_tag, It first, It last, Compare comp = {},
+                Proj proj = {}) {
+  merge_sort(first, last, comp, proj);
+}
+
+template <typename It, typename Compare = less<>, typename Proj = identity>
+void sort_range(unstable_tag, It first, It last, Compare comp = {},
+                Proj proj = {}) {
+  quick_sort2(first, last, comp, proj);
+}
+
+template <typename It, typename Compare = less<>, typename Proj = identity>
+void sort_range(It first, It last, Compare comp = {}, Proj proj = {}) {
+  sort_range(unstable_tag{}, first, last, comp, proj);
+}
+
+}  // namespace P
+#endif /* SORT_HPP */
@@ -0,0 +1,93 @@
+#ifndef TOP_K_HPP
+#define TOP_K_HPP
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace P {
+using namespace std;
+
+/*
+ * Keep the k smallest elements of a stream
+ *
+ * h is a max-heap (w.r.t. comp) of size <= k, so h.front() is the k'th
+ * smallest element seen so far
+ *
+ * Time complexity:
+ * - push: O(1) if the element is rejected, O(log k) otherwise
+ * - sorted: O(k log k)
+ * Space complexity: O(k)
+ *
+ * Prefer partial_quick_sort when the whole input is in memory and k is not
+ * much smaller than n
+ */
+template <typename E, typename Compare = less<E>>
+class TopK {
+ public:
+  TopK(size_t k, Compare comp = Compare()) : k(k), comp(comp) { h.reserve(k); }
+
+  void push(E const& e) {
+    if (h.size() < k) {
+      h.push_back(e);
+      push_heap(begin(h), end(h), comp);
+    } else if (k && comp(e, h.front())) {
+      replace_top(e);
+    }
+  }
+
+  template <typename It>
+  void push(It first, It last) {
+    for (; first != last; ++first) push(*first);
+  }
+
+  size_t size() const { return h.size(); }
+  bool full() const { return h.size() == k; }
+
+  // k'th smallest element so far (largest one kept)
+  E const& top() const { return h.front(); }
+
+  // kept elements in ascending order
+  vector<E> sorted() const {
+    auto res = h;
+    sort_heap(begin(res), end(res), comp);
+    return res;
+  }
+
+ private:
+  /*
+   * Equivalent to pop_heap + push_heap with a single sift-down
+   */
+  void replace_top(E const& e) {
+    const size_t n = h.size();
+    size_t i = 0;
+    while (true) {
+      size_t c = 2 * i + 1;
+      if (c >= n) break;
+      if (c + 1 < n && comp(h[c], h[c + 1])) ++c;
+      if (!comp(e, h[c])) break;
+      h[i] = move(h[c]);
+      i = c;
+    }
+    h[i] = e;
+  }
+
+  size_t k;
+  Compare comp;
+  vector<E> h;  // max-heap
+};
+
+/*
+ * Return the k smallest elements of [first, last) in ascending order
+ */
+template <typename It, typename Compare = less<>,
+          typename E = typename iterator_traits<It>::value_type>
+vector<E> top_k(It first, It last, size_t k, Compare comp = {}) {
+  TopK<E, Compare> t(k, comp);
+  t.push(first, last);
+  return t.sorted();
+}
+
+}  // namespace P
+#endif /* TOP_K_HPP */
@@ -0,0 +1,75 @@
+#ifndef BINARY_LIFTING_HPP
+#define BINARY_LIFTING_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "util/parallel.hpp"
+
+namespace P {
+using namespace std;
+
+/*
+ * Binary lifting (jump pointers) over a function f: [0, n) -> [0, n), e.g.
+ * the successors of a FunctionalGraph or the parents of a rooted tree (the
+ * root being its own parent)
+ *
+ * Level j holds f^(2^j); levels are stored one after the other, each built
+ * from the previous one in parallel. Only the levels needed for jumps up to
+ * max_k are kept: 10^8 vertices take 400 MB per level.
+ *
+ * Jumps beyond max_k take steps of the longest level and stop at a fixed
+ * point, so they are cheap on trees (clamped at the root) but O(k / max_k)
+ * around a cycle: FunctionalGraph::jump_table reduces k with the cycles
+ * first.
+ *
+ * Space complexity: O(|V| log max_k)
+ * Time complexity:
+ * - construction: O(|V| log max_k / threads)
+ * - jump(v, k): O(log k) for k <= max_k, plus O(k / max_k) beyond
+ */
+class BinaryLifting {
+ public:
+  BinaryLifting() = default;
+
+  BinaryLifting(vector<int> const& f, long long max_k, int nthreads = 0)
+      : n(f.size()), L(1) {
+    while (L < 62 && (1LL << L) <= max_k) ++L;
+    constexpr int Grain = 1 << 16;
+    if (n < Grain) nthreads = 1;
+    table.resize(size_t(L) * n);
+    copy(f.begin(), f.end(), table.begin());
+    for (int j = 1; j < L; ++j) {
+      int const* prev = up(j - 1);
+      int* cur = table.data() + size_t(j) * n;
+      parallel_for(0, n, [&](int v) { cur[v] = prev[prev[v]]; }, nthreads);
+    }
+  }
+
+  int N() const { return n; }
+  int levels() const { return L; }
+
+  // f^(2^j)
+  int const* up(int j) const { return table.data() + size_t(j) * n; }
+  int up(int j, int v) const { return up(j)[v]; }
+
+  // f^k(v), k >= 0
+  int jump(int v, long long k) const {
+    for (; k >> L; k -= 1LL << (L - 1)) {
+      int u = up(L - 1, v);
+      if (u == v) return v;  // fixed point, e.g. the root of a tree
+      v = u;
+    }
+    for (int j = 0; k; ++j, k >>= 1)
+      if (k & 1) v = up(j, v);
+    return v;
+  }
+
+ private:
+  int n = 0;
+  int L = 0;  // levels
+  vector<int> table;
+};
+
+}  // namespace P
+#endif /* BINARY_LIFTING_HPP */
@@ -0,0 +1,162 @@
+#ifndef BIT_ADJMAT_HPP
+#define BIT_ADJMAT_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace P {
+using namespace std;
+
+/*
+ * Bit-packed Adjacency Matrix
+ *
+ * (u -> v) is an edge <=> bit v of row u is set. Rows are padded to whole
+ * 64-bit words (the padding bits stay 0), so the row operations below run a
+ * word at a time in plain loops the compiler vectorizes: 64 potential edges
+ * per word instead of one int per edge in AdjMat.
+ *
+ * Rows are contiguous, columns are not: for column access transpose() once,
+ * it moves 64 x 64 tiles instead of single bits.
+ *
+ * Space complexity: O(|V|^2 / 64)
+ * Time complexity:
+ * - set / test: O(1)
+ * - row operations (degree, common_neighbors, row_or): O(|V| / 64)
+ */
+class BitAdjMat {
+ public:
+  BitAdjMat(int n = 0) : n(n), W((n + 63) / 64), bits(size_t(n) * W) {}
+
+  int N() const { return n; }
+  int words() const { return W; }  // per row
+
+  bool test(int u, int v) const { return row(u)[v >> 6] >> (v & 63) & 1; }
+  bool operator[](pair<int, int> p) const { return test(p.first, p.second); }
+  void set(int u, int v, bool b = true) {
+    auto bit = uint64_t(1) << (v & 63);
+    if (b)
+      row(u)[v >> 6] |= bit;
+    else
+      row(u)[v >> 6] &= ~bit;
+  }
+
+  uint64_t* row(int u) { return bits.data() + size_t(u) * W; }
+  uint64_t const* row(int u) const { return bits.data() + size_t(u) * W; }
+
+  // out-degree
+  int degree(int u) const {
+    auto r = row(u);
+    int c = 0;
+    for (int q = 0; q < W; ++q) c += __builtin_popcountll(r[q]);
+    return c;
+  }
+
+  // |succ(u) & succ(v)|
+  int common_neighbors(int u, int v) const {
+    auto a = row(u), b = row(v);
+    int c = 0;
+    for (int q = 0; q < W; ++q) c += __builtin_popcountll(a[q] & b[q]);
+    return c;
+  }
+
+  // succ(dst) |= succ(src)
+  void row_or(int dst, int src) {
+    auto a = row(dst);
+    auto b = row(src);
+    for (int q = 0; q < W; ++q) a[q] |= b[q];
+  }
+
+  /*
+   * Number of triangles of an undirected graph
+   *
+   * Every edge {u, v} adds its common neighbors, which counts each triangle
+   * once per edge
+   *
+   * Precondition: symmetric, no self loops
+   *
+   * Time complexity: O(|E| |V| / 64)
+   */
+  long long triangles() const {
+    long long c = 0;
+    for (int u = 0; u < n; ++u) {
+      auto r = row(u);
+      for (int q = u >> 6; q < W; ++q)
+        for (auto x = r[q]; x; x &= x - 1) {
+          int v = q << 6 | __builtin_ctzll(x);
+          if (v > u) c += common_neighbors(u, v);
+        }
+    }
+    return c / 3;
+  }
+
+  /*
+   * Warshall's algorithm by rows: a row reaching k takes every successor of k
+   *
+   * test(u, v) in the result <=> a path of length >= 1 from u to v
+   *
+   * Time complexity: O(|V|^3 / 64)
+   */
+  BitAdjMat transitive_closure() const {
+    BitAdjMat res = *this;
+    for (int k = 0; k < n; ++k)
+      for (int u = 0; u < n; ++u)
+        if (res.test(u, k)) res.row_or(u, k);
+    return res;
+  }
+
+  /*
+   * The reversed graph, by 64 x 64 tiles: gather 64 words of a tile column,
+   * transpose them in registers, scatter them to a tile row
+   *
+   * Time complexity: O(|V|^2 / 64 * log 64)
+   */
+  BitAdjMat transpose() const {
+    BitAdjMat res(n);
+    uint64_t tile[64];
+    for (int bi = 0; bi < W; ++bi)
+      for (int bj = 0; bj < W; ++bj) {
+        for (int r = 0; r < 64; ++r) {
+          int u = bi << 6 | r;
+          tile[r] = u < n ? row(u)[bj] : 0;
+        }
+        transpose64(tile);
+        for (int r = 0; r < 64 && (bj << 6 | r) < n; ++r)
+          res.row(bj << 6 | r)[bi] = tile[r];
+      }
+    return res;
+  }
+
+  bool operator==(BitAdjMat const& o) const {
+    return n == o.n && bits == o.bits;
+  }
+  bool operator!=(BitAdjMat const& o) const { return !(*this == o); }
+
+  friend ostream& operator<<(ostream& os, BitAdjMat const& mat) {
+    for (int u = 0; u < mat.n; ++u) {
+      for (int v = 0; v < mat.n; ++v) os << (v ? ", " : "") << mat.test(u, v);
+      os << '\n';
+    }
+    return os;
+  }
+
+ private:
+  // bit c of a[r] <-> bit r of a[c], swapping blocks of 32, 16, ..., 1 bits
+  static void transpose64(uint64_t* a) {
+    uint64_t m = 0x00000000FFFFFFFF;
+    for (int j = 32; j != 0; j >>= 1, m ^= m << j)
+      for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+        uint64_t t = ((a[k] >> j) ^ a[k | j]) & m;
+        a[k] ^= t << j;
+        a[k | j] ^= t;
+      }
+  }
+
+  int n;
+  int W;  // words per row
+  vector<uint64_t> bits;
+};
+
+}  // namespace P
+#endif /* BIT_ADJMAT_HPP */
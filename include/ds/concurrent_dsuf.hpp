@@ -0,0 +1,94 @@
+#ifndef CONCURRENT_DSUF_HPP
+#define CONCURRENT_DSUF_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace P {
+using namespace std;
+/*
+ * reference:
+ * Jayanti, Tarjan. A Randomized Concurrent Algorithm for Disjoint Set Union
+ * (PODC 2016)
+ */
+
+/*
+ * Concurrent Disjoint Set Union Find
+ *
+ * Any number of threads may call root / same_set / uni at the same time.
+ *
+ * - p[i] == i for roots (no size is stored: it cannot be kept consistent with
+ *   the parent in a single CAS)
+ * - union by index: the root with the lower priority is linked under the
+ *   other one with a single CAS on its parent; the priority is a bijective
+ *   hash of the index, so the linking order is effectively random and
+ *   adversarial inputs cannot build deep trees
+ * - root uses path splitting: every visited node is CAS'd to its grandparent.
+ *   A failed CAS means another thread already moved it up, so it is not
+ *   retried and root finishes in O(path length) steps
+ *
+ * same_set and uni are linearizable.
+ */
+class ConcurrentDSUF {
+ public:
+  ConcurrentDSUF(int n) : n(n), p(new atomic<int>[n]) {
+    for (int i = 0; i < n; ++i) p[i].store(i, memory_order_relaxed);
+  }
+
+  int size() const { return n; }
+
+  int root(int u) {
+    while (true) {
+      int v = p[u].load(memory_order_acquire);
+      if (v == u) return u;
+      int w = p[v].load(memory_order_acquire);
+      if (v != w)
+        p[u].compare_exchange_weak(v, w, memory_order_acq_rel,
+                                   memory_order_relaxed);
+      u = v;
+    }
+  }
+
+  bool same_set(int u, int v) {
+    while (true) {
+      u = root(u);
+      v = root(v);
+      if (u == v) return true;
+      // u was still a root after v was found: disjoint at that point
+      if (p[u].load() == u) return false;
+    }
+  }
+
+  /*
+   * Return false if u and v were already in the same set
+   */
+  bool uni(int u, int v) {
+    while (true) {
+      u = root(u);
+      v = root(v);
+      if (u == v) return false;
+      if (higher(u, v)) swap(u, v);
+      int expected = u;  // u must still be a root
+      if (p[u].compare_exchange_strong(expected, v)) return true;
+    }
+  }
+
+ private:
+  static uint32_t prio(uint32_t x) {  // murmur3 finalizer, a bijection
+    x ^= x >> 16;
+    x *= 0x85ebca6b;
+    x ^= x >> 13;
+    x *= 0xc2b2ae35;
+    x ^= x >> 16;
+    return x;
+  }
+  static bool higher(int u, int v) { return prio(u) > prio(v); }
+
+  int n;
+  unique_ptr<atomic<int>[]> p;  // parents
+};
+
+}  // namespace P
+#endif /* CONCURRENT_DSUF_HPP */
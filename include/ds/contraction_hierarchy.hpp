@@ -0,0 +1,420 @@
+#ifndef CONTRACTION_HIERARCHY_HPP
+#define CONTRACTION_HIERARCHY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "ds/graph.hpp"
+#include "util/file.hpp"
+#include "util/parallel.hpp"
+
+namespace P {
+using namespace std;
+/*
+ * reference:
+ * Geisberger, Sanders, Schultes, Delling. Contraction Hierarchies: Faster
+ * and Simpler Hierarchical Routing in Road Networks (WEA 2008)
+ */
+
+/*
+ * Contraction hierarchy of a weighted directed graph
+ *
+ * Preprocessing contracts the vertices one by one: a contracted vertex v is
+ * removed and every path u -> v -> x it was the only shortest path for is
+ * replaced by a shortcut u -> x. Whether it was is decided by a witness
+ * search, a Dijkstra from u that avoids v and gives up after
+ * WitnessSettleLimit vertices or once all the x are settled (so a few
+ * shortcuts may be unnecessary, never missing). The contraction order is the
+ * rank.
+ *
+ * Vertices are contracted in rounds of independent sets: the vertices whose
+ * priority (edge difference + contracted neighbors, estimated with
+ * PrioritySettleLimit) is smaller than that of all their remaining
+ * neighbors. Within a round the witness searches avoid the whole set and
+ * only read the graph, so they run on nthreads threads.
+ *
+ * A query runs Dijkstra upward from s on the edges to higher ranks and
+ * upward from t on the reversed edges from higher ranks; they meet at the
+ * highest vertex of a shortest path.
+ *
+ * Space complexity: O(|V| + |E| + shortcuts)
+ */
+class ContractionHierarchy {
+ public:
+  // vertices settled by a witness search, when contracting / estimating
+  static constexpr int WitnessSettleLimit = 500, PrioritySettleLimit = 50;
+
+  // mid: the contracted vertex a shortcut bypasses, -1 for an original edge
+  struct Arc {
+    int v, w, mid;
+  };
+
+  ContractionHierarchy() = default;
+
+  /*
+   * Precondition: weighted graph (neighbors are WeightedNode) without
+   * negative edges
+   */
+  template <typename G>
+  explicit ContractionHierarchy(G const& g, int nthreads = 0) : n(g.N()) {
+    Builder b(n);
+    for (int u = 0; u < n; ++u)
+      for (auto [v, w] : g[u])
+        if (u != v) b.add_arc(u, v, w, -1);
+    b.contract(num_threads(nthreads));
+    rank = move(b.rank);
+    to_csr(b.up, up_off, up);
+    to_csr(b.down, down_off, down);
+  }
+
+  int N() const { return n; }
+  int rank_of(int v) const { return rank[v]; }
+  size_t arcs() const { return up.size() + down.size(); }
+
+  /*
+   * Distance from s to t (INF if unreachable); ws.meet is the highest vertex
+   * of the shortest path found
+   */
+  int query(BidirectionalWorkspace& ws, int s, int t) const {
+    auto& f = ws.fwd;
+    auto& b = ws.bwd;
+    f.reset(n);
+    b.reset(n);
+    f.relax(s, 0, -1);
+    b.relax(t, 0, -1);
+    int mu = INF;
+    ws.meet = -1;
+    auto head = [](auto& side) {
+      return side.q.empty() ? INF : side.q.top().first;
+    };
+    while (min(head(f), head(b)) < mu) {
+      bool forward = head(f) <= head(b);
+      auto& side = forward ? f : b;
+      auto& other = forward ? b : f;
+      auto [d, u] = side.q.pop();
+      if (other.dis[u] != INF && d + other.dis[u] < mu)
+        mu = d + other.dis[u], ws.meet = u;
+      auto const& off = forward ? up_off : down_off;
+      auto const& arcs = forward ? up : down;
+      for (int q = off[u]; q < off[u + 1]; ++q) {
+        auto [v, w, _] = arcs[q];
+        if (d + w < side.dis[v]) side.relax(v, d + w, u);
+      }
+    }
+    if (mu == INF) ws.meet = -1;
+    return mu;
+  }
+
+  int query(int s, int t) const {
+    BidirectionalWorkspace ws;
+    return query(ws, s, t);
+  }
+
+  /*
+   * Vertices of the shortest path found by the last query on ws (shortcuts
+   * unpacked), empty if there was none
+   */
+  vector<int> path(BidirectionalWorkspace const& ws) const {
+    if (ws.meet == -1) return {};
+    vector<int> hi = ws.fwd.path(ws.meet);  // s ... meet, upward
+    for (int v = ws.bwd.pred[ws.meet]; v != -1; v = ws.bwd.pred[v])
+      hi.push_back(v);  // ... t, downward
+    vector<int> res{hi[0]};
+    for (int q = 0; q + 1 < (int)hi.size(); ++q)
+      unpack(hi[q], hi[q + 1], res);
+    return res;
+  }
+
+  /*
+   * Binary file in native byte order: magic, |V|, rank, then the up and down
+   * arcs as offsets + arcs
+   */
+  void save(string const& path) const {
+    auto f = open_file(path, "wb");
+    write_values(f.get(), Magic, sizeof(Magic));
+    write_values(f.get(), &n, 1);
+    write_vector(f.get(), rank);
+    write_vector(f.get(), up_off);
+    write_vector(f.get(), up);
+    write_vector(f.get(), down_off);
+    write_vector(f.get(), down);
+    if (fflush(f.get())) throw system_error(errno, generic_category(), path);
+  }
+
+  static ContractionHierarchy load(string const& path) {
+    auto f = open_file(path, "rb");
+    char magic[sizeof(Magic)];
+    read_values(f.get(), magic, sizeof(Magic));
+    if (memcmp(magic, Magic, sizeof(Magic)))
+      throw invalid_argument(path + ": not a contraction hierarchy");
+    ContractionHierarchy ch;
+    read_values(f.get(), &ch.n, 1);
+    ch.rank = read_vector<int>(f.get());
+    ch.up_off = read_vector<int>(f.get());
+    ch.up = read_vector<Arc>(f.get());
+    ch.down_off = read_vector<int>(f.get());
+    ch.down = read_vector<Arc>(f.get());
+    if (!ch.valid())
+      throw invalid_argument(path + ": corrupt contraction hierarchy");
+    return ch;
+  }
+
+ private:
+  static constexpr char Magic[8] = {'P', 'D', 'S', 'C', 'H', '0', '0', '1'};
+
+  /*
+   * Working graph during preprocessing: out and in arcs of the remaining
+   * vertices, one arc (the shortest) per ordered pair
+   */
+  struct Builder {
+    enum State : char { REMAINING, IN_ROUND, CONTRACTED };
+
+    Builder(int n)
+        : out(n), in(n), up(n), down(n), rank(n, -1), prio(n), deleted(n),
+          state(n, REMAINING) {}
+
+    void add_arc(int u, int v, int w, int mid) {
+      auto it = find_if(out[u].begin(), out[u].end(),
+                        [v](Arc const& a) { return a.v == v; });
+      if (it == out[u].end()) {
+        out[u].push_back({v, w, mid});
+        in[v].push_back({u, w, mid});
+      } else if (w < it->w) {
+        *it = {v, w, mid};
+        for (auto& a : in[v])
+          if (a.v == u) a = {u, w, mid};
+      }
+    }
+
+    /*
+     * Shortcuts (u, x, w) needed when v is contracted; the witness searches
+     * avoid v and every vertex not REMAINING, and stop after settle_limit
+     * vertices or once every target is settled
+     */
+    template <typename F>
+    void shortcuts(int v, DijkstraWorkspace<>& ws, int settle_limit,
+                   F emit) const {
+      auto open = [&](int y) { return y != v && state[y] == REMAINING; };
+      for (auto [u, wu, _] : in[v]) {
+        if (!open(u)) continue;
+        int max_w = -1, targets = 0;
+        for (auto [x, wx, __] : out[v])
+          if (open(x) && x != u) max_w = max(max_w, wx), ++targets;
+        if (targets == 0) continue;
+        int limit = wu + max_w, settled = 0;
+        ws.reset(out.size());
+        ws.relax(u, 0, -1);
+        while (!ws.q.empty() && targets > 0) {
+          auto [d, y] = ws.q.pop();
+          if (d > limit || ++settled > settle_limit) break;
+          for (auto [x, __, ___] : out[v]) targets -= x == y && x != u;
+          for (auto [z, w, __] : out[y])
+            if (open(z) && d + w < ws.dis[z]) ws.relax(z, d + w, y);
+        }
+        for (auto [x, wx, __] : out[v])
+          if (open(x) && x != u && ws.dis[x] > wu + wx) emit(u, x, wu + wx);
+      }
+    }
+
+    // edge difference + contracted neighbors
+    int priority(int v, DijkstraWorkspace<>& ws) const {
+      int added = 0, removed = 0;
+      shortcuts(v, ws, PrioritySettleLimit, [&added](int, int, int) {
+        ++added;
+      });
+      for (auto const& a : out[v]) removed += state[a.v] == REMAINING;
+      for (auto const& a : in[v]) removed += state[a.v] == REMAINING;
+      return added - removed + deleted[v];
+    }
+
+    // f(tid, v) for v in vs on nthreads threads
+    template <typename F>
+    static void for_each(vector<int> const& vs, int nthreads, F f) {
+      const int m = vs.size();
+      nthreads = max(1, min(nthreads, m / 64));
+      run_threads(nthreads, [&](int t) {
+        for (int q = (long long)m * t / nthreads,
+                 e = (long long)m * (t + 1) / nthreads;
+             q < e; ++q)
+          f(t, vs[q]);
+      });
+    }
+
+    void contract(int nthreads) {
+      const int n = out.size();
+      vector<DijkstraWorkspace<>> ws(nthreads);
+      vector<int> rem(n), round, touched;
+      for (int v = 0; v < n; ++v) rem[v] = v;
+      for_each(rem, nthreads,
+               [&](int t, int v) { prio[v] = priority(v, ws[t]); });
+
+      auto before = [this](int a, int b) {
+        return tie(prio[a], a) < tie(prio[b], b);
+      };
+      vector<vector<tuple<int, int, int>>> found;  // shortcuts per vertex
+      int next = 0;
+      while (!rem.empty()) {
+        round.clear();
+        for (int v : rem) {
+          bool local_min = true;
+          for (auto const& a : out[v]) local_min &= before(v, a.v);
+          for (auto const& a : in[v]) local_min &= before(v, a.v);
+          if (local_min) round.push_back(v);
+        }
+        for (int v : round) state[v] = IN_ROUND;
+
+        found.assign(round.size(), {});
+        vector<int> idx(round.size());
+        for (int q = 0; q < (int)round.size(); ++q) idx[q] = q;
+        for_each(idx, nthreads, [&](int t, int q) {
+          shortcuts(round[q], ws[t], WitnessSettleLimit,
+                    [&found, q](int u, int x, int w) {
+                      found[q].push_back({u, x, w});
+                    });
+        });
+
+        touched.clear();
+        for (int q = 0; q < (int)round.size(); ++q) {
+          int v = round[q];
+          rank[v] = next++;
+          for (auto const& a : out[v]) {  // a.v is REMAINING
+            up[v].push_back(a);
+            erase_arcs(in[a.v], v);
+            ++deleted[a.v];
+            touched.push_back(a.v);
+          }
+          for (auto const& a : in[v]) {
+            down[v].push_back(a);
+            erase_arcs(out[a.v], v);
+            ++deleted[a.v];
+            touched.push_back(a.v);
+          }
+          for (auto [u, x, w] : found[q]) add_arc(u, x, w, v);
+          out[v] = {};
+          in[v] = {};
+          state[v] = CONTRACTED;
+        }
+
+        sort(touched.begin(), touched.end());
+        touched.erase(unique(touched.begin(), touched.end()), touched.end());
+        for_each(touched, nthreads,
+                 [&](int t, int v) { prio[v] = priority(v, ws[t]); });
+        rem.erase(remove_if(rem.begin(), rem.end(),
+                            [this](int v) { return state[v] != REMAINING; }),
+                  rem.end());
+      }
+    }
+
+    static void erase_arcs(vector<Arc>& arcs, int v) {
+      arcs.erase(remove_if(arcs.begin(), arcs.end(),
+                           [v](Arc const& a) { return a.v == v; }),
+                 arcs.end());
+    }
+
+    vector<vector<Arc>> out, in;  // remaining graph
+    vector<vector<Arc>> up;       // arcs to higher ranks
+    vector<vector<Arc>> down;     // reversed arcs from higher ranks
+    vector<int> rank, prio, deleted;
+    vector<State> state;
+  };
+
+  static void to_csr(vector<vector<Arc>>& adj, vector<int>& off,
+                     vector<Arc>& arcs) {
+    off.assign(adj.size() + 1, 0);
+    for (size_t u = 0; u < adj.size(); ++u)
+      off[u + 1] = off[u] + adj[u].size();
+    arcs.clear();
+    arcs.reserve(off.back());
+    for (auto& a : adj) {
+      arcs.insert(arcs.end(), a.begin(), a.end());
+      a = {};
+    }
+  }
+
+  // append the original path of the arc a -> b (without a) to res
+  void unpack(int a, int b, vector<int>& res) const {
+    vector<pair<int, int>> todo{{a, b}};
+    while (!todo.empty()) {
+      auto [u, v] = todo.back();
+      todo.pop_back();
+      Arc const* arc = find_arc(u, v);
+      if (!arc) throw logic_error("contraction hierarchy: missing arc");
+      int mid = arc->mid;
+      if (mid == -1) {
+        res.push_back(v);
+      } else {
+        todo.push_back({mid, v});
+        todo.push_back({u, mid});
+      }
+    }
+  }
+
+  // offsets of arcs from 0 to arcs.size(), non-decreasing; vertices < n
+  static bool valid_arcs(int n, vector<int> const& off,
+                         vector<Arc> const& arcs) {
+    if (off[0] != 0 || off[n] != (int)arcs.size()) return false;
+    for (int u = 0; u < n; ++u)
+      if (off[u] > off[u + 1]) return false;
+    for (auto [v, _, mid] : arcs)
+      if (v < 0 || v >= n || mid < -1 || mid >= n) return false;
+    return true;
+  }
+
+  /*
+   * Everything query and path rely on, checked after load:
+   * - the sizes, offsets and vertices of both arc arrays
+   * - rank is a permutation and every arc is stored at its lower end
+   * - the two arcs a shortcut u -> v bypasses through mid exist and
+   *   rank[mid] is below rank[u] and rank[v], so unpack terminates
+   */
+  bool valid() const {
+    if (n < 0 || (int)rank.size() != n || (int)up_off.size() != n + 1 ||
+        (int)down_off.size() != n + 1 || !valid_arcs(n, up_off, up) ||
+        !valid_arcs(n, down_off, down))
+      return false;
+    vector<char> seen(n);
+    for (int r : rank) {
+      if (r < 0 || r >= n || seen[r]) return false;
+      seen[r] = true;
+    }
+    auto bypass = [this](int u, int v, int mid) {  // for the arc u -> v
+      return mid == -1 || (rank[mid] < min(rank[u], rank[v]) &&
+                           find_arc(u, mid) && find_arc(mid, v));
+    };
+    for (int x = 0; x < n; ++x) {
+      for (int q = up_off[x]; q < up_off[x + 1]; ++q)
+        if (rank[up[q].v] <= rank[x] || !bypass(x, up[q].v, up[q].mid))
+          return false;
+      for (int q = down_off[x]; q < down_off[x + 1]; ++q)
+        if (rank[down[q].v] <= rank[x] || !bypass(down[q].v, x, down[q].mid))
+          return false;
+    }
+    return true;
+  }
+
+  // the arc u -> v, stored at the lower ranked end; nullptr if none
+  Arc const* find_arc(int u, int v) const {
+    bool upward = rank[u] < rank[v];
+    auto const& off = upward ? up_off : down_off;
+    auto const& arcs = upward ? up : down;
+    int at = upward ? u : v, to = upward ? v : u;
+    auto b = arcs.begin() + off[at], e = arcs.begin() + off[at + 1];
+    auto it = find_if(b, e, [to](Arc const& a) { return a.v == to; });
+    return it == e ? nullptr : &*it;
+  }
+
+  int n = 0;
+  vector<int> rank;              // contraction order
+  vector<int> up_off, down_off;  // CSR offsets
+  vector<Arc> up;                // u -> v with rank[u] < rank[v]
+  vector<Arc> down;              // at v: u -> v with rank[u] > rank[v]
+};
+
+}  // namespace P
+#endif /* CONTRACTION_HIERARCHY_HPP */
@@ -0,0 +1,159 @@
+#ifndef CSR_GRAPH_HPP
+#define CSR_GRAPH_HPP
+
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ds/graph.hpp"
+
+namespace P {
+using namespace std;
+
+/*
+ * Neighbors of one vertex: [b, e) of a CsrGraph array
+ */
+template <typename It>
+struct NeighborRange {
+  It begin() const { return b; }
+  It end() const { return e; }
+  size_t size() const { return e - b; }
+  bool empty() const { return b == e; }
+  decltype(auto) operator[](size_t i) const { return b[i]; }
+
+  It b, e;
+};
+
+/*
+ * Zips the destination and weight arrays of a weighted CsrGraph, yields
+ * WeightedNode by value
+ */
+struct WeightedNodeIt {
+  using iterator_category = forward_iterator_tag;
+  using value_type = WeightedNode;
+  using difference_type = ptrdiff_t;
+  using pointer = void;
+  using reference = WeightedNode;
+
+  WeightedNode operator*() const { return {*v, *w}; }
+  WeightedNode operator[](ptrdiff_t i) const { return {v[i], w[i]}; }
+  WeightedNodeIt& operator++() {
+    ++v, ++w;
+    return *this;
+  }
+  WeightedNodeIt operator++(int) { return {v++, w++}; }
+  ptrdiff_t operator-(WeightedNodeIt o) const { return v - o.v; }
+  bool operator==(WeightedNodeIt o) const { return v == o.v; }
+  bool operator!=(WeightedNodeIt o) const { return v != o.v; }
+
+  int const* v;
+  int const* w;
+};
+
+/*
+ * Compressed Sparse Row graph
+ *
+ * Static graph: the neighbors of u are dst[off[u], off[u + 1]), so a
+ * traversal reads two contiguous arrays instead of one heap block per
+ * vertex. With WeightedNode the weights live in their own array
+ * (struct of arrays) and neighbors are yielded as WeightedNode by value.
+ *
+ * Same algorithms as AdjList (GraphAlgo)
+ *
+ * Space complexity: O(|V| + |E|), 4 bytes per vertex and sizeof(Dest) per
+ * edge
+ * Time complexity:
+ * - build: O(|V| + |E|)
+ * - query adjacency: O(1) to get the range of neighbors
+ */
+template <typename Dest = Node>
+struct CsrGraph : GraphAlgo<CsrGraph<Dest>> {
+  static constexpr bool Weighted = is_same_v<Dest, WeightedNode>;
+  using Target = conditional_t<Weighted, int, Dest>;
+
+  CsrGraph(int n = 0) : off(n + 1) {}
+
+  /*
+   * From (source, dest) pairs; the neighbors of every vertex keep the order
+   * of the edge list (counting sort by source)
+   */
+  CsrGraph(int n, vector<pair<int, Dest>> const& edges) : off(n + 1) {
+    for (auto const& e : edges) ++off[e.first + 1];
+    for (int u = 0; u < n; ++u) off[u + 1] += off[u];
+    resize_edges(edges.size());
+    vector<int> pos(off.begin(), off.end() - 1);
+    for (auto const& [u, d] : edges) set_edge(pos[u]++, d);
+  }
+
+  explicit CsrGraph(AdjList<Dest> const& al) : off(al.N() + 1) {
+    for (int u = 0; u < al.N(); ++u) off[u + 1] = off[u] + al[u].size();
+    resize_edges(off.back());
+    for (int u = 0; u < al.N(); ++u)
+      for (int q = 0; q < (int)al[u].size(); ++q)
+        set_edge(off[u] + q, al[u][q]);
+  }
+
+  int N() const { return off.size() - 1; }
+  int M() const { return off.back(); }  // number of (directed) edges
+
+  auto operator[](int u) const {
+    int b = off[u], e = off[u + 1];
+    if constexpr (Weighted)
+      return NeighborRange<WeightedNodeIt>{{dst.data() + b, w.data() + b},
+                                           {dst.data() + e, w.data() + e}};
+    else
+      return NeighborRange<Target const*>{dst.data() + b, dst.data() + e};
+  }
+
+  // same graph with every edge reversed
+  CsrGraph transpose() const {
+    vector<pair<int, Dest>> edges;
+    edges.reserve(M());
+    for (int u = 0; u < N(); ++u)
+      for (Dest e : (*this)[u]) {
+        int v = e;
+        e.val = u;
+        edges.push_back({v, e});
+      }
+    return CsrGraph(N(), edges);
+  }
+
+  vector<int> const& offsets() const { return off; }
+  vector<Target> const& targets() const { return dst; }
+  vector<int> const& weights() const { return w; }  // only with WeightedNode
+
+  friend ostream& operator<<(ostream& os, CsrGraph const& g) {
+    for (int q = 0; q < g.N(); ++q) {
+      os << q << ": ";
+      auto r = g[q];
+      for (size_t i = 0; i < r.size(); ++i) os << (i ? ", " : "") << r[i];
+      os << '\n';
+    }
+    return os;
+  }
+
+ private:
+  void resize_edges(size_t m) {
+    dst.resize(m);
+    if constexpr (Weighted) w.resize(m);
+  }
+
+  void set_edge(int i, Dest const& d) {
+    if constexpr (Weighted)
+      dst[i] = d.val, w[i] = d.w;
+    else
+      dst[i] = d;
+  }
+
+  vector<int> off;     // neighbors of u: [off[u], off[u + 1])
+  vector<Target> dst;  // destinations
+  vector<int> w;       // weights, only with WeightedNode
+};
+
+using WeightedCsrGraph = CsrGraph<WeightedNode>;
+
+}  // namespace P
+#endif /* CSR_GRAPH_HPP */
@@ -0,0 +1,109 @@
+#ifndef DARY_HEAP_HPP
+#define DARY_HEAP_HPP
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace P {
+using namespace std;
+
+/*
+ * Indexed d-ary min-heap of (key, item) with items in [0, n)
+ *
+ * pos[item] locates every item in the heap, so the key of an item can be
+ * decreased in place and the heap never holds more than n entries (no lazy
+ * duplicates). The heap array stores the keys next to the items, so sifting
+ * compares keys without an indirection. D = 4 keeps the children of a node
+ * in one cache line and halves the depth of a binary heap.
+ *
+ * Time complexity:
+ * - push / decrease: O(log_D n)
+ * - pop: O(D log_D n)
+ * - clear: O(size)
+ */
+template <int D = 4>
+class IndexedDaryHeap {
+ public:
+  IndexedDaryHeap(int n = 0) : pos(n, -1) {}
+
+  // empty the heap for items in [0, n)
+  void clear(int n) {
+    for (auto [_, v] : heap) pos[v] = -1;
+    heap.clear();
+    if ((int)pos.size() != n) pos.assign(n, -1);
+  }
+
+  bool empty() const { return heap.empty(); }
+  int size() const { return heap.size(); }
+  bool contains(int v) const { return pos[v] != -1; }
+  int key(int v) const { return heap[pos[v]].first; }
+  pair<int, int> top() const { return heap[0]; }  // (key, item)
+
+  /*
+   * Insert v, or decrease its key if v is present
+   *
+   * Precondition: key <= key(v) if v is present
+   */
+  void push(int v, int key) {
+    int i = pos[v];
+    if (i == -1) {
+      i = heap.size();
+      heap.push_back({key, v});
+    } else {
+      heap[i].first = key;
+    }
+    sift_up(i);
+  }
+
+  pair<int, int> pop() {
+    auto res = heap[0];
+    pos[res.second] = -1;
+    auto last = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+      heap[0] = last;
+      sift_down(0);
+    }
+    return res;
+  }
+
+ private:
+  void sift_up(int i) {
+    auto e = heap[i];
+    while (i > 0) {
+      int p = (i - 1) / D;
+      if (heap[p].first <= e.first) break;
+      place(i, heap[p]);
+      i = p;
+    }
+    place(i, e);
+  }
+
+  void sift_down(int i) {
+    auto e = heap[i];
+    const int n = heap.size();
+    while (true) {
+      int c = D * i + 1;
+      if (c >= n) break;
+      int best = c;
+      for (int q = c + 1; q < min(c + D, n); ++q)
+        if (heap[q].first < heap[best].first) best = q;
+      if (e.first <= heap[best].first) break;
+      place(i, heap[best]);
+      i = best;
+    }
+    place(i, e);
+  }
+
+  void place(int i, pair<int, int> e) {
+    heap[i] = e;
+    pos[e.second] = i;
+  }
+
+  vector<pair<int, int>> heap;  // (key, item)
+  vector<int> pos;              // index in heap, or -1
+};
+
+}  // namespace P
+#endif /* DARY_HEAP_HPP */
@@ -2,8 +2,13 @@
 #define DSUF_HPP
 
 #include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
 #include <vector>
 
+#include "util/ntp.hpp"
+
 namespace P {
 using namespace std;
 /*
@@ -11,32 +16,107 @@ using namespace std;
  * https://github.com/spaghetti-source/algorithm/blob/master/data_structure/union_find.cc
  */
 
+/*
+ * Policies (named template parameters, see util/ntp.hpp)
+ *
+ * dsuf_index<T>: index type, e.g. int64_t or uint32_t for more than 2^31 - 1
+ *                elements (default int)
+ * dsuf_by_rank:  union by rank with a byte per element for the rank instead
+ *                of union by size; set sizes are not available
+ */
+NTP_POLICY_TYPE(dsuf_index);
+NTP_POLICY_PRESENT(dsuf_by_rank);
+
 /*
  * Disjoint Set Union Find
+ *
+ * root is iterative with path halving (every other node on the path is
+ * pointed to its grandparent), so no recursion depth is involved however
+ * long a path gets before it is compressed
+ *
+ * Layout:
+ * - union by size: p[i] = parent, or -size for roots (Index must be signed)
+ * - union by rank: p[i] = parent, or i for roots; rank[i] in a uint8_t
+ *   (rank <= log2(n) < 64), so Index may be unsigned
+ *
+ * Time complexity: O(alpha(n)) amortized per operation
  */
-class DSUF {
+template <typename... Args>
+class BasicDSUF {
  public:
-  DSUF(int n) : p(n, -1) {}
+  NTP_TYPE(Index, dsuf_index, int);
+  NTP_PRESENT(ByRank, dsuf_by_rank);
+  NTP_VALIDATE(dsuf_index_ID, dsuf_by_rank_ID);
+  static_assert(ByRank || is_signed_v<Index>,
+                "union by size stores -size in the parent array");
+
+  BasicDSUF(Index n = 0) : p(n, -1) {
+    if constexpr (ByRank) {
+      iota(begin(p), end(p), Index(0));
+      rank.assign(n, 0);
+    }
+  }
+
+  Index N() const { return p.size(); }
 
-  // with path compression
-  int root(int i) { return p[i] < 0 ? i : p[i] = root(p[i]); }
+  void reserve(Index n) {
+    p.reserve(n);
+    if constexpr (ByRank) rank.reserve(n);
+  }
+
+  // add a singleton set, return its element
+  Index add_element() {
+    Index i = p.size();
+    if constexpr (ByRank) {
+      p.push_back(i);
+      rank.push_back(0);
+    } else {
+      p.push_back(-1);
+    }
+    return i;
+  }
 
-  bool same_set(int i, int j) { return root(i) == root(j); }
+  // with path halving
+  Index root(Index i) {
+    if constexpr (ByRank) {
+      while (p[i] != i) i = p[i] = p[p[i]];  // p[root] == root
+    } else {
+      while (p[i] >= 0) {
+        if (p[p[i]] >= 0) p[i] = p[p[i]];
+        i = p[i];
+      }
+    }
+    return i;
+  }
 
-  void uni(int u, int v) {
+  bool same_set(Index i, Index j) { return root(i) == root(j); }
+
+  void uni(Index u, Index v) {
     u = root(u);
     v = root(v);
     if (u == v) return;  // erase this if no check
-    if (p[u] > p[v]) swap(u, v);
-    p[u] += p[v];
-    p[v] = u;
+    if constexpr (ByRank) {
+      if (rank[u] < rank[v]) swap(u, v);
+      rank[u] += rank[u] == rank[v];
+      p[v] = u;
+    } else {
+      if (p[u] > p[v]) swap(u, v);
+      p[u] += p[v];
+      p[v] = u;
+    }
   }
 
-  int size(int u) { return -p[root(u)]; }
+  Index size(Index u) {
+    static_assert(!ByRank, "set sizes are only kept with union by size");
+    return -p[root(u)];
+  }
 
  private:
-  vector<int> p;  // parents (and negative size(/rank) for roots)
+  vector<Index> p;       // parents (and negative size for roots)
+  vector<uint8_t> rank;  // only with dsuf_by_rank
 };
 
+using DSUF = BasicDSUF<>;
+
 }  // namespace P
 #endif /* DSUF_HPP */
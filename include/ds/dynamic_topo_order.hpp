@@ -0,0 +1,157 @@
+#ifndef DYNAMIC_TOPO_ORDER_HPP
+#define DYNAMIC_TOPO_ORDER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace P {
+using namespace std;
+
+/*
+ * Topological order of a DAG maintained under edge insertions
+ * (Pearce & Kelly, "A Dynamic Topological Sort Algorithm for Directed
+ * Acyclic Graphs", 2006)
+ *
+ * ord[v] is the position of v and at[i] the vertex at position i. Adding
+ * u -> v with ord[u] < ord[v] keeps the order. Otherwise only the affected
+ * region ord[v] .. ord[u] is searched: F, the vertices reachable from v, and
+ * B, the vertices reaching u, both restricted to that region. Reaching u from
+ * v means the edge closes a cycle; else B then F are moved into the positions
+ * they occupied together, every other vertex stays in place.
+ *
+ * Time complexity:
+ * - add_edge: O(1) if the order is kept, else O(d log d) where d counts the
+ *   vertices of F and B and their edges
+ * - construction: O(|V| + |E|)
+ * Space complexity: O(|V| + |E|)
+ */
+class DynamicTopoOrder {
+ public:
+  // n vertices, no edges
+  DynamicTopoOrder(int n = 0)
+      : ord(n), at(n), out(n), in(n), stamp(n, 0) {
+    iota(ord.begin(), ord.end(), 0);
+    iota(at.begin(), at.end(), 0);
+  }
+
+  /*
+   * Starting from the edges of g, with G a GraphAlgo (AdjList, CsrGraph, ...)
+   *
+   * Throw invalid_argument if g is cyclic
+   */
+  template <typename G>
+  explicit DynamicTopoOrder(G const& g) : DynamicTopoOrder(g.N()) {
+    int i = 0;
+    g.topological_sort([&](int v) {
+      ord[v] = i;
+      at[i++] = v;
+    });
+    if (i != N()) throw invalid_argument("DynamicTopoOrder: cyclic graph");
+    for (int u = 0; u < N(); ++u)
+      for (auto v : g[u]) {
+        out[u].push_back(v);
+        in[v].push_back(u);
+      }
+  }
+
+  int N() const { return ord.size(); }
+  int position(int v) const { return ord[v]; }
+  vector<int> const& order() const { return at; }
+  bool precedes(int u, int v) const { return ord[u] < ord[v]; }
+
+  /*
+   * Add the edge u -> v and restore the order
+   *
+   * Return false, and leave the graph unchanged, if the edge would close a
+   * cycle (including u == v)
+   */
+  bool add_edge(int u, int v) {
+    if (u == v) return false;
+    if (ord[v] < ord[u]) {
+      next_epoch();
+      if (!forward(v, ord[u])) return false;
+      backward(u, ord[v]);
+      reorder();
+    }
+    out[u].push_back(v);
+    in[v].push_back(u);
+    return true;
+  }
+
+ private:
+  void next_epoch() {
+    if (epoch == UINT32_MAX) {
+      fill(stamp.begin(), stamp.end(), 0);
+      epoch = 0;
+    }
+    ++epoch;
+  }
+
+  // F: vertices reachable from v at positions < ub; false if ord ub reached
+  bool forward(int v, int ub) {
+    fwd.clear();
+    stack = {v};
+    stamp[v] = epoch;
+    while (!stack.empty()) {
+      int x = stack.back();
+      stack.pop_back();
+      fwd.push_back(x);
+      for (int y : out[x]) {
+        if (ord[y] == ub) return false;
+        if (ord[y] < ub && stamp[y] != epoch) {
+          stamp[y] = epoch;
+          stack.push_back(y);
+        }
+      }
+    }
+    return true;
+  }
+
+  // B: vertices reaching u at positions > lb (disjoint from F, no cycle)
+  void backward(int u, int lb) {
+    bwd.clear();
+    stack = {u};
+    stamp[u] = epoch;
+    while (!stack.empty()) {
+      int x = stack.back();
+      stack.pop_back();
+      bwd.push_back(x);
+      for (int y : in[x])
+        if (ord[y] > lb && stamp[y] != epoch) {
+          stamp[y] = epoch;
+          stack.push_back(y);
+        }
+    }
+  }
+
+  // B keeps its relative order, then F does, in the union of their slots
+  void reorder() {
+    auto by_ord = [this](int a, int b) { return ord[a] < ord[b]; };
+    sort(fwd.begin(), fwd.end(), by_ord);
+    sort(bwd.begin(), bwd.end(), by_ord);
+    slots.clear();
+    for (int x : bwd) slots.push_back(ord[x]);
+    for (int x : fwd) slots.push_back(ord[x]);
+    inplace_merge(slots.begin(), slots.begin() + bwd.size(), slots.end());
+    int i = 0;
+    for (int x : bwd) place(x, slots[i++]);
+    for (int x : fwd) place(x, slots[i++]);
+  }
+
+  void place(int v, int i) {
+    ord[v] = i;
+    at[i] = v;
+  }
+
+  vector<int> ord, at;
+  vector<vector<int>> out, in;
+  vector<uint32_t> stamp;  // == epoch: in F or B of the current insertion
+  uint32_t epoch = 0;
+  vector<int> fwd, bwd, slots, stack;
+};
+
+}  // namespace P
+#endif /* DYNAMIC_TOPO_ORDER_HPP */
@@ -1,15 +1,29 @@
 #ifndef GRAPH_HPP
 #define GRAPH_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
 #include <queue>
+#include <random>
 #include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "algo/counting_sort.hpp"
+#include "ds/binary_lifting.hpp"
+#include "ds/bit_adjmat.hpp"
+#include "ds/concurrent_dsuf.hpp"
+#include "ds/dary_heap.hpp"
+#include "ds/dsuf.hpp"
 #include "prettyprint.hpp"
+#include "util/parallel.hpp"
 
 /*
  * Representation of graphs
@@ -77,6 +91,9 @@ struct AdjMat {
   }
   const int N;
 
+  int* row(int y) { return mat.data() + y * N; }
+  int const* row(int y) const { return mat.data() + y * N; }
+
   friend ostream& operator<<(ostream& os, AdjMat& mat) {
     mat.print(os);
     return os;
@@ -109,47 +126,189 @@ struct AdjMat {
 };
 
 /*
- * Adjacency List
+ * Result of parallel_bfs: -1 for vertices not reached, parent[root] = root
+ */
+struct BfsTree {
+  vector<int> depth;
+  vector<int> parent;
+};
+
+/*
+ * Result of the minimum spanning forest algorithms: edges (u, v, w) with
+ * u < v, in the order they were chosen by kruskal and prim; boruvka lists
+ * them round by round, in unspecified order within a round
+ */
+struct SpanningForest {
+  long long weight = 0;
+  vector<tuple<int, int, int>> edges;
+};
+
+/*
+ * Buffers of GraphAlgo::dijkstra, reused across queries
  *
- * Can be used for Directed/Undirected graph
+ * Queue: IndexedDaryHeap (default), RadixHeap or BucketQueue
+ * (ds/monotone_queue.hpp), or any type with the same clear(n) / empty /
+ * push(item, key) / pop interface
  *
- * Space complexity: O(|V| + |E|)
- * Time complexity:
- * - Add vertex: O(1)
- * - add edge: O(1)
- * - remove edge: O(|V|)
- * - query adjacency: O(|V|) for all the neighbors of a particular vertex
+ * Only the vertices reached by the previous query are reset, so a query that
+ * stops early at its target costs nothing for the rest of the graph
+ */
+template <typename Queue = IndexedDaryHeap<>>
+struct DijkstraWorkspace {
+  DijkstraWorkspace(Queue q = Queue()) : q(move(q)) {}
+
+  void reset(int n) {
+    if ((int)dis.size() != n) {
+      dis.assign(n, INF);
+      pred.assign(n, -1);
+    } else {
+      for (int v : touched) dis[v] = INF, pred[v] = -1;
+    }
+    touched.clear();
+    q.clear(n);
+  }
+
+  // dis[v] = d via u, queued with priority key (d unless A*)
+  void relax(int v, int d, int u, int key) {
+    if (dis[v] == INF) touched.push_back(v);
+    dis[v] = d;
+    pred[v] = u;
+    q.push(v, key);
+  }
+  void relax(int v, int d, int u) { relax(v, d, u, d); }
+
+  // vertices from the source to t, empty if t was not reached
+  vector<int> path(int t) const {
+    vector<int> res;
+    if (dis[t] == INF) return res;
+    for (int v = t; v != -1; v = pred[v]) res.push_back(v);
+    reverse(res.begin(), res.end());
+    return res;
+  }
+
+  vector<int> dis;      // distance, INF if not reached
+  vector<int> pred;     // predecessor on a shortest path, -1 for the source
+  vector<int> touched;  // vertices with dis != INF
+  Queue q;
+};
+
+/*
+ * Buffers of GraphAlgo::bidirectional_dijkstra: one search from the source
+ * on the graph, one from the target on its transpose
+ */
+struct BidirectionalWorkspace {
+  // vertices from the source to the target, empty if not connected
+  vector<int> path() const {
+    if (meet == -1) return {};
+    auto res = fwd.path(meet);
+    for (int v = bwd.pred[meet]; v != -1; v = bwd.pred[v]) res.push_back(v);
+    return res;
+  }
+
+  DijkstraWorkspace<> fwd, bwd;
+  int meet = -1;  // a vertex on a shortest path, -1 if none
+};
+
+/*
+ * Buffers of the depth-first searches of GraphAlgo, reused across calls
  *
- * To provide custom Dest Node, provide a conversion function to Node
- * and a conversion function to int (for destination)
+ * Colors are epoch stamps: reset() moves to a new epoch instead of clearing,
+ * so a traversal costs nothing for the vertices it does not reach. In the
+ * current epoch a vertex is white (stamp < epoch), gray (on the stack,
+ * stamp == epoch) or black (finished, stamp == epoch + 1).
  */
-template <typename Dest = Node>
-struct AdjList {
-  AdjList(int n) : neigh(n) {}
-  vector<Dest>& operator[](int x) { return neigh[x]; }
-  vector<Dest> const& operator[](int x) const { return neigh[x]; }
-  int N() const { return neigh.size(); }
+struct TraversalWorkspace {
+  void reset(int n) {
+    if ((int)stamp.size() != n || epoch > UINT32_MAX - 4) {
+      stamp.assign(n, 0);
+      epoch = 1;
+    } else {
+      epoch += 2;
+    }
+    stack.clear();
+  }
 
-  using iterator = typename vector<vector<Dest>>::iterator;
-  using const_iterator = typename vector<vector<Dest>>::const_iterator;
-  iterator begin() { return neigh.begin(); }
-  iterator end() { return neigh.end(); }
-  const_iterator begin() const { return cbegin(); }
-  const_iterator end() const { return cend(); }
-  const_iterator cbegin() const { return neigh.cbegin(); }
-  const_iterator cend() const { return neigh.cend(); }
+  bool white(int v) const { return stamp[v] < epoch; }
+  bool gray(int v) const { return stamp[v] == epoch; }
+  bool black(int v) const { return stamp[v] == epoch + 1; }
 
-  friend ostream& operator<<(ostream& os, AdjList& al) {
-    for (int q = 0; q < al.N(); ++q) {
-      os << q << ": ";
-      int M = al[q].size();
-      for (int w = 0; w < M - 1; ++w) {
-        os << al[q][w] << ", ";
+  vector<uint32_t> stamp;
+  uint32_t epoch = 0;
+  vector<pair<int, int>> stack;  // (vertex, index of its next edge)
+};
+
+/*
+ * Callbacks of GraphAlgo::dfs_visit. Derive and hide the ones needed (static
+ * dispatch, no virtual calls); set stop to end the traversal.
+ */
+struct DfsVisitor {
+  void pre(int) {}                          // discovered (turns gray)
+  void post(int) {}                         // finished (turns black)
+  void tree_edge(int, int) {}               // to a white vertex
+  void back_edge(int, int) {}               // to a gray vertex (ancestor)
+  void forward_or_cross_edge(int, int) {}   // to a black vertex
+  bool stop = false;
+};
+
+template <typename Dest = Node>
+struct AdjList;
+
+/*
+ * Algorithms shared by the graph representations (CRTP)
+ *
+ * G provides N() and a const operator[](u) returning an iterable range of the
+ * neighbors of u (with size()), whose elements convert to int
+ */
+template <typename G>
+struct GraphAlgo {
+  /*
+   * Iterative depth-first search from root with an explicit stack in ws:
+   * the edges of a vertex are explored in order and classified by the color
+   * of their head
+   *
+   * Precondition: ws.reset(N()) was called, root is white. Vertices stay
+   * colored, so calling it again for every white vertex visits a forest
+   *
+   * Time complexity: O(|V| + |E|) for the reached part, no recursion
+   */
+  template <typename Visitor>
+  void dfs_visit(TraversalWorkspace& ws, Node root, Visitor& vis) const {
+    uint32_t* stamp = ws.stamp.data();
+    const uint32_t gray = ws.epoch, black = ws.epoch + 1;
+    auto& st = ws.stack;
+    auto discover = [&](int u) {
+      stamp[u] = gray;
+      st.push_back({u, 0});
+      vis.pre(u);
+    };
+    discover(root);
+    while (!st.empty() && !vis.stop) {
+      auto [u, i] = st.back();
+      auto const& nb = g()[u];
+      const int deg = nb.size();
+      int v = -1;
+      for (; i < deg; ++i) {  // up to the first white head
+        int x = nb[i];
+        if (stamp[x] < gray) {
+          v = x;
+          break;
+        }
+        if (stamp[x] == gray)
+          vis.back_edge(u, x);
+        else
+          vis.forward_or_cross_edge(u, x);
+        if (vis.stop) return;
+      }
+      if (v != -1) {
+        st.back().second = i + 1;
+        vis.tree_edge(u, v);
+        if (!vis.stop) discover(v);
+      } else if (i == deg) {
+        stamp[u] = black;
+        st.pop_back();
+        vis.post(u);
       }
-      if (!al[q].empty()) os << al[q][M - 1];
-      os << '\n';
     }
-    return os;
   }
 
   /*
@@ -160,14 +319,19 @@ struct AdjList {
    */
   template <typename F>
   void dfs(Node root, F f) const {
-    vector<int> visited(N());
-    auto dfs_ = [this, &visited, &f](Node node, auto dfs__) {
-      if (visited[node]) return;
-      visited[node] = true;
-      f(node);
-      for (auto v : neigh[node]) dfs__(v, dfs__);
-    };
-    dfs_(root, dfs_);
+    TraversalWorkspace ws;
+    dfs(ws, root, f);
+  }
+
+  template <typename F>
+  void dfs(TraversalWorkspace& ws, Node root, F f) const {
+    struct : DfsVisitor {
+      F* f;
+      void pre(int u) { (*f)(Node(u)); }
+    } vis;
+    vis.f = &f;
+    ws.reset(N());
+    dfs_visit(ws, root, vis);
   }
 
   /*
@@ -175,11 +339,25 @@ struct AdjList {
    */
   template <typename F>
   void dfs_dtree(Node root, F f) const {
-    auto dfs_ = [this, &f](Node node, auto dfs__) -> void {
-      f(node);
-      for (auto v : neigh[node]) dfs__(v, dfs__);
-    };
-    dfs_(root, dfs_);
+    TraversalWorkspace ws;
+    dfs_dtree(ws, root, f);
+  }
+
+  template <typename F>
+  void dfs_dtree(TraversalWorkspace& ws, Node root, F f) const {
+    auto& st = ws.stack;
+    st.assign(1, {root, 0});
+    f(root);
+    while (!st.empty()) {
+      auto& [u, i] = st.back();
+      if (i == (int)g()[u].size()) {
+        st.pop_back();
+        continue;
+      }
+      int v = g()[u][i++];
+      f(Node(v));
+      st.push_back({v, 0});
+    }
   }
 
   template <typename F>
@@ -192,7 +370,7 @@ struct AdjList {
       auto u = q.front();
       q.pop();
       f(u);
-      for (auto v : neigh[u]) {
+      for (auto v : g()[u]) {
         if (visited[v]) continue;
         visited[v] = true;
         q.push(v);
@@ -210,7 +388,7 @@ struct AdjList {
       auto u = q.front();
       q.pop();
       f(u, depth[u]);
-      for (auto v : neigh[u]) {
+      for (auto v : g()[u]) {
         if (depth[v] != -1) continue;
         depth[v] = depth[u] + 1;
         q.push(v);
@@ -218,6 +396,126 @@ struct AdjList {
     }
   }
 
+  /*
+   * Level-synchronous parallel bfs with direction optimization
+   * (Beamer, Asanovic, Patterson. Direction-Optimizing Breadth-First Search,
+   * SC 2012)
+   *
+   * Precondition: undirected graph (every edge is stored in both directions)
+   *
+   * - top-down step: the threads scan blocks of the frontier (a vertex list)
+   *   and claim unvisited neighbors with an atomic fetch_or on a visited
+   *   bitmap
+   * - bottom-up step: the threads scan blocks of the unvisited vertices and
+   *   look for any neighbor in the frontier (a bitmap); a vertex stops at the
+   *   first one, which skips most edges once the frontier is large
+   * Switches to bottom-up when the frontier has more than 1/Alpha of the
+   * unexplored edges, back to top-down when it has less than 1/Beta of the
+   * vertices
+   *
+   * depth equals the one given by bfs_depth; parent is a bfs tree, but which
+   * of the possible parents is chosen depends on the thread schedule
+   *
+   * Time complexity: O(|V| + |E|) work, O(diameter) synchronizations
+   */
+  BfsTree parallel_bfs(Node root, int nthreads = 0) const {
+    constexpr int Alpha = 14, Beta = 24, Grain = 1024;
+    nthreads = num_threads(nthreads);
+    const int n = N(), W = (n + 63) / 64;
+    BfsTree t{vector<int>(n, -1), vector<int>(n, -1)};
+    vector<atomic<uint64_t>> seen(W);
+    vector<uint64_t> fbits, nbits;  // frontier bitmaps (bottom-up)
+    vector<int> front{root};        // frontier list (top-down)
+    vector<vector<int>> next(nthreads);
+    vector<long long> deg(nthreads);  // edges of the vertices found
+    vector<int> cnt(nthreads);
+    auto bit = [](int v) { return uint64_t(1) << (v & 63); };
+
+    seen[root >> 6] = bit(root);
+    t.depth[root] = 0;
+    t.parent[root] = root;
+    long long m_u = 0, m_f = g()[root].size();  // unexplored, frontier edges
+    for (int u = 0; u < n; ++u) m_u += g()[u].size();
+    m_u -= m_f;
+    long long n_f = 1;
+    bool bottom_up = false;
+
+    for (int d = 1; n_f > 0; ++d) {
+      if (!bottom_up && m_f > m_u / Alpha) {
+        bottom_up = true;
+        fbits.assign(W, 0);
+        for (int u : front) fbits[u >> 6] |= bit(u);
+      } else if (bottom_up && n_f < n / Beta) {
+        bottom_up = false;
+        front.clear();
+        for (int q = 0; q < W; ++q)
+          for (uint64_t b = fbits[q]; b; b &= b - 1)
+            front.push_back(q * 64 + __builtin_ctzll(b));
+      }
+
+      fill(deg.begin(), deg.end(), 0);
+      fill(cnt.begin(), cnt.end(), 0);
+      if (!bottom_up) {
+        const int nf = front.size();
+        int nt = nf < Grain ? 1 : nthreads;
+        run_threads(nt, [&](int tid) {
+          auto& out = next[tid];
+          out.clear();
+          for (int q = (long long)nf * tid / nt,
+                   e = (long long)nf * (tid + 1) / nt;
+               q < e; ++q) {
+            int u = front[q];
+            for (auto x : g()[u]) {
+              int v = x;
+              auto& s = seen[v >> 6];
+              if (s.load(memory_order_relaxed) & bit(v)) continue;
+              if (s.fetch_or(bit(v), memory_order_relaxed) & bit(v)) continue;
+              t.depth[v] = d;
+              t.parent[v] = u;
+              deg[tid] += g()[v].size();
+              out.push_back(v);
+            }
+          }
+        });
+        front.clear();
+        for (int q = 0; q < nt; ++q)
+          front.insert(front.end(), next[q].begin(), next[q].end());
+        n_f = front.size();
+      } else {
+        nbits.assign(W, 0);
+        run_threads(nthreads, [&](int tid) {  // blocks of whole words
+          for (int q = (long long)W * tid / nthreads,
+                   e = (long long)W * (tid + 1) / nthreads;
+               q < e; ++q) {
+            uint64_t todo = ~seen[q].load(memory_order_relaxed);
+            if (q == W - 1 && n % 64) todo &= bit(n) - 1;
+            for (; todo; todo &= todo - 1) {
+              int v = q * 64 + __builtin_ctzll(todo);
+              for (auto x : g()[v]) {
+                int u = x;
+                if (!(fbits[u >> 6] & bit(u))) continue;
+                t.depth[v] = d;
+                t.parent[v] = u;
+                nbits[q] |= bit(v);
+                deg[tid] += g()[v].size();
+                ++cnt[tid];
+                break;
+              }
+            }
+            seen[q].fetch_or(nbits[q], memory_order_relaxed);
+          }
+        });
+        fbits.swap(nbits);
+        n_f = 0;
+        for (int c : cnt) n_f += c;
+      }
+      m_f = 0;
+      for (auto x : deg) m_f += x;
+      m_u -= m_f;
+    }
+    return t;
+  }
+
   /*
    * Time complexity: O(|V|+|E|)
    *
@@ -230,7 +528,7 @@ struct AdjList {
   void topological_sort(F f) const {
     vector<int> in_deg(N());
     for (int u = 0; u < N(); ++u)
-      for (auto v : neigh[u]) ++in_deg[v];
+      for (auto v : g()[u]) ++in_deg[v];
     queue<Node> q;
     for (int u = 0; u < N(); ++u)
       if (in_deg[u] == 0) q.push(u);
@@ -239,7 +537,7 @@ struct AdjList {
       auto u = q.front();
       q.pop();
       f(u);
-      for (auto v : neigh[u])
+      for (auto v : g()[u])
         if (--in_deg[v] == 0) q.push(v);
     }
   }
@@ -257,18 +555,67 @@ struct AdjList {
       pseq[seq[q]] = q;
     }
     for (int u = 0; u < N(); ++u)
-      for (auto v : neigh[u])
+      for (auto v : g()[u])
         if (pseq[u] >= pseq[v]) return false;
 
     return true;
   }
 
+  /*
+   * Level-synchronous parallel Kahn's algorithm, for scheduling: every vertex
+   * of levels[k] only depends on vertices of levels[0..k) (k is the length
+   * of the longest path ending at it), so a level can run in parallel
+   *
+   * The in-degrees are atomic counters; the threads split the current level,
+   * and the vertex whose decrement reaches 0 joins the next level. Each
+   * level is sorted, so the result does not depend on the schedule.
+   *
+   * A vertex on a cycle or reachable from one is in no level, so the levels
+   * hold fewer than N() vertices iff the graph is cyclic
+   *
+   * Time complexity: O(|V| + |E|) work plus sorting the levels
+   */
+  vector<vector<int>> topological_levels(int nthreads = 0) const {
+    constexpr int Grain = 1024;
+    nthreads = num_threads(nthreads);
+    vector<atomic<int>> in_deg(N());
+    parallel_for(
+        0, N(),
+        [&](int u) {
+          for (auto v : g()[u]) in_deg[v].fetch_add(1, memory_order_relaxed);
+        },
+        nthreads);
+
+    vector<vector<int>> levels, next(nthreads);
+    vector<int> front;
+    for (int u = 0; u < N(); ++u)
+      if (in_deg[u].load(memory_order_relaxed) == 0) front.push_back(u);
+    while (!front.empty()) {
+      const int n = front.size();
+      int nt = n < Grain ? 1 : nthreads;
+      run_threads(nt, [&](int t) {
+        next[t].clear();
+        for (int q = (long long)n * t / nt, e = (long long)n * (t + 1) / nt;
+             q < e; ++q)
+          for (auto v : g()[front[q]])
+            if (in_deg[v].fetch_sub(1, memory_order_relaxed) == 1)
+              next[t].push_back(v);
+      });
+      levels.push_back(move(front));
+      front.clear();
+      for (int t = 0; t < nt; ++t)
+        front.insert(front.end(), next[t].begin(), next[t].end());
+      sort(front.begin(), front.end());
+    }
+    return levels;
+  }
+
   template <typename F>
   void topological_sort_lex(F f) const {
     vector<int> in_deg(N());
     for (int u = 0; u < N(); ++u)
-      for (auto v : neigh[u]) ++in_deg[v];
-    priority_queue<Node, vector<int>, greater<int>> q;
+      for (auto v : g()[u]) ++in_deg[v];
+    priority_queue<int, vector<int>, greater<int>> q;
     for (int u = 0; u < N(); ++u)
       if (in_deg[u] == 0) q.push(u);
 
@@ -276,110 +623,1373 @@ struct AdjList {
       auto u = q.top();
       q.pop();
       f(u);
-      for (auto v : neigh[u])
+      for (auto v : g()[u])
         if (--in_deg[v] == 0) q.push(v);
     }
   }
 
   bool is_cyclic() const {
-    vector<int> color(N());
-    auto dfs_ = [this, &color](Node u, auto dfs__) -> bool {
-      color[u] = 1;
-      for (auto v : neigh[u])
-        if (color[v] == 1 || (color[v] == 0 && dfs__(v, dfs__))) return true;
-
-      color[u] = 2;
-      return false;
-    };
-    for (int q = 0; q < N(); ++q)
-      if (!color[q] && dfs_(q, dfs_)) return true;
+    TraversalWorkspace ws;
+    return is_cyclic(ws);
+  }
 
-    return false;
+  bool is_cyclic(TraversalWorkspace& ws) const {
+    struct : DfsVisitor {
+      void back_edge(int, int) { stop = true; }
+    } vis;
+    ws.reset(N());
+    for (int q = 0; q < N() && !vis.stop; ++q)
+      if (ws.white(q)) dfs_visit(ws, q, vis);
+    return vis.stop;
   }
 
   /*
    * Return a cycle with an implicit step from path[N - 1] to path[0]
+   *
+   * The cycle closed by the first back edge (u, v): the stack from v to u
    */
   vector<Node> find_cycle() const {
-    vector<int> color(N());
-    vector<Node> succ(N());  // successor
-    pair<Node, Node> cycle_ends{0, 0};
-    auto dfs_ = [this, &color, &succ, &cycle_ends](Node u, auto dfs__) -> bool {
-      color[u] = 1;
-      for (auto v : neigh[u])
-        if (color[v] == 0) {
-          succ[u] = v;
-          if (dfs__(v, dfs__)) return true;
-        } else if (color[v] == 1) {
-          cycle_ends = {u, v};
-          return true;
-        }
-      color[u] = 2;
-      return false;
-    };
-    for (int q = 0; q < N(); ++q)
-      if (!color[q] && dfs_(q, dfs_)) {
-        auto [a, b] = cycle_ends;
-        vector<Node> res;
-        for (auto v = b; v != a; v = succ[v]) res.push_back(v);
-        res.push_back(a);
-        return res;
+    TraversalWorkspace ws;
+    return find_cycle(ws);
+  }
+
+  vector<Node> find_cycle(TraversalWorkspace& ws) const {
+    struct : DfsVisitor {
+      TraversalWorkspace* ws;
+      vector<Node> res;
+      void back_edge(int, int v) {
+        auto& st = ws->stack;
+        int q = st.size() - 1;
+        while (st[q].first != v) --q;
+        for (; q < (int)st.size(); ++q) res.push_back(st[q].first);
+        stop = true;
       }
-    return {};
+    } vis;
+    vis.ws = &ws;
+    ws.reset(N());
+    for (int q = 0; q < N() && !vis.stop; ++q)
+      if (ws.white(q)) dfs_visit(ws, q, vis);
+    return vis.res;
   }
 
   AdjMat to_adjmat() const {
     AdjMat mat(N());
     for (int q = 0; q < N(); ++q)
-      for (int v : neigh[q]) mat[{q, v}] += 1;
+      for (int v : g()[q]) mat[{q, v}] += 1;
 
     return mat;
   }
 
+  BitAdjMat to_bit_adjmat() const {
+    BitAdjMat mat(N());
+    for (int q = 0; q < N(); ++q)
+      for (int v : g()[q]) mat.set(q, v);
+
+    return mat;
+  }
+
+  /*
+   * Implicit step from path[M - 1] to path[0]
+   *
+   * The steps are hashed, then the neighbors of each distinct vertex of the
+   * path are scanned once, removing the steps they provide
+   *
+   * Time complexity: O(M + sum of the degrees of the vertices of path)
+   * expected
+   */
   bool has_cycle(vector<Node> const& path) const {
-    return to_adjmat().has_cycle(path);
+    const int M = path.size();
+    if (M == 0) return false;
+    auto key = [](int u, int v) { return uint64_t(u) << 32 | uint32_t(v); };
+    unordered_set<uint64_t> steps;
+    for (int q = 0; q < M; ++q) steps.insert(key(path[q], path[(q + 1) % M]));
+    vector<int> from;
+    for (auto s : steps) from.push_back(s >> 32);
+    sort(from.begin(), from.end());
+    from.erase(unique(from.begin(), from.end()), from.end());
+    for (int u : from)
+      for (int v : g()[u]) steps.erase(key(u, v));
+    return steps.empty();
   }
 
   bool is_functional() const {
-    return all_of(cbegin(), cend(),
-                  [](auto const& adj_list) { return adj_list.size() < 2; });
+    for (int u = 0; u < N(); ++u)
+      if (g()[u].size() >= 2) return false;
+    return true;
   }
 
- private:
-  vector<vector<Dest>> neigh;  // list of adjacent vertices
-};
+  /*
+   * Label connected components 0, 1, 2... in order of their smallest vertex
+   *
+   * Precondition: undirected graph (every edge is stored in both directions)
+   *
+   * Afforest-style parallel union-find on a ConcurrentDSUF:
+   * 1. link every vertex to its first NeighborRounds neighbors
+   * 2. sample vertices to guess the largest component c
+   * 3. link the remaining edges of the vertices outside c; edges from c are
+   *    skipped since the other endpoint links its copy of the edge
+   * The vertices are split among the threads by edge count, not vertex count
+   *
+   * Time complexity: O((|V| + |E|) alpha(|V|) / threads) expected
+   */
+  vector<int> connected_components(int nthreads = 0) const {
+    constexpr int NeighborRounds = 2, Samples = 1024;
+    nthreads = num_threads(nthreads);
+    ConcurrentDSUF d(N());
+    vector<long long> off(N() + 1);  // edge prefix sums
+    for (int u = 0; u < N(); ++u) off[u + 1] = off[u] + g()[u].size();
+    auto for_vertices = [&](auto f) {  // edge-balanced vertex blocks
+      auto at = [&](int t) {  // first vertex of block t
+        if (t == nthreads) return N();
+        auto m = off[N()] * t / nthreads;
+        return int(lower_bound(off.begin(), off.end(), m) - off.begin());
+      };
+      run_threads(nthreads, [&](int t) {
+        for (int u = at(t), e = at(t + 1); u < e; ++u) f(u);
+      });
+    };
 
-struct WeightedAdjList : public AdjList<WeightedNode> {
-  using Base = AdjList<WeightedNode>;
-  using Base::Base;
+    for (int r = 0; r < NeighborRounds; ++r)
+      for_vertices([&](int u) {
+        if (r < (int)g()[u].size()) d.uni(u, int(g()[u][r]));
+      });
+
+    int c = -1;
+    if (N() > 0) {
+      mt19937 gen(N());
+      uniform_int_distribution<> dis(0, N() - 1);
+      unordered_map<int, int> freq;
+      int best = 0;
+      for (int q = 0; q < Samples; ++q) {
+        int r = d.root(dis(gen));
+        if (++freq[r] > best) best = freq[r], c = r;
+      }
+    }
+
+    for_vertices([&](int u) {
+      if (d.root(u) == c) return;
+      for (int q = NeighborRounds; q < (int)g()[u].size(); ++q)
+        d.uni(u, int(g()[u][q]));
+    });
+
+    vector<int> label(N(), -1);
+    int cnt = 0;
+    for (int u = 0; u < N(); ++u) {
+      int r = d.root(u);
+      if (label[r] == -1) label[r] = cnt++;
+      label[u] = label[r];
+    }
+    return label;
+  }
+
+  /*
+   * Sequential reference for connected_components: bfs from every unvisited
+   * vertex, same labels
+   */
+  vector<int> connected_components_bfs() const {
+    vector<int> label(N(), -1);
+    int cnt = 0;
+    queue<int> q;
+    for (int s = 0; s < N(); ++s) {
+      if (label[s] != -1) continue;
+      label[s] = cnt;
+      q.push(s);
+      while (!q.empty()) {
+        int u = q.front();
+        q.pop();
+        for (auto v : g()[u])
+          if (label[v] == -1) label[v] = cnt, q.push(v);
+      }
+      ++cnt;
+    }
+    return label;
+  }
+
+  /*
+   * Vertex orderings for locality of the traversals. Each returns a
+   * permutation, perm[v] = new id of v, to relabel the graph with
+   * (AdjList::relabel / relabeled).
+   */
+
+  /*
+   * Highest out-degree first, ties by id: the hubs, which most edges point
+   * to, share few cache lines
+   *
+   * Time complexity: O(|V| + max degree)
+   */
+  vector<int> degree_order() const {
+    int maxd = 0;
+    for (int u = 0; u < N(); ++u) maxd = max(maxd, (int)g()[u].size());
+    vector<int> pos(maxd + 2), perm(N());  // by maxd - degree
+    for (int u = 0; u < N(); ++u) ++pos[maxd - (int)g()[u].size() + 1];
+    for (int d = 0; d <= maxd; ++d) pos[d + 1] += pos[d];
+    for (int u = 0; u < N(); ++u) perm[u] = pos[maxd - (int)g()[u].size()]++;
+    return perm;
+  }
+
+  /*
+   * Reverse Cuthill-McKee: BFS from a vertex of minimum degree in every
+   * component, the new neighbors of a vertex taken by increasing degree,
+   * then the order reversed. Adjacent vertices get close ids (small
+   * bandwidth), so a traversal front stays in a narrow range of memory.
+   *
+   * Meant for undirected graphs (follows the out-edges)
+   *
+   * Time complexity: O(|V| log |V| + |E| log(max degree))
+   */
+  vector<int> rcm_order() const {
+    const int n = N();
+    auto deg_less = [this](int a, int b) {
+      return make_pair(g()[a].size(), a) < make_pair(g()[b].size(), b);
+    };
+    vector<int> starts(n), order, nb;
+    iota(starts.begin(), starts.end(), 0);
+    sort(starts.begin(), starts.end(), deg_less);
+    order.reserve(n);
+    vector<char> seen(n);
+    for (int s : starts) {
+      if (seen[s]) continue;
+      seen[s] = true;
+      order.push_back(s);
+      for (size_t head = order.size() - 1; head < order.size(); ++head) {
+        nb.clear();
+        for (int v : g()[order[head]])
+          if (!seen[v]) seen[v] = true, nb.push_back(v);
+        sort(nb.begin(), nb.end(), deg_less);
+        order.insert(order.end(), nb.begin(), nb.end());
+      }
+    }
+    vector<int> perm(n);
+    for (int i = 0; i < n; ++i) perm[order[i]] = n - 1 - i;
+    return perm;
+  }
+
+  /*
+   * Community order, after Rabbit Order (Arai et al. Rabbit Order:
+   * Just-in-time Parallel Reordering for Fast Graph Analysis, IPDPS 2016),
+   * sequential
+   *
+   * The graph is taken as undirected with unit weights. Vertices are visited
+   * by increasing degree; each one merges into the neighboring community of
+   * highest modularity gain
+   *   dQ(u, c) = 2 (w(u, c) / 2m - d(u) d(c) / (2m)^2)
+   * if it is positive, and becomes a child of it in a dendrogram; the edges
+   * of a community are merged lazily, when it is visited. A DFS of every
+   * dendrogram tree gives the order, so each community and each of its sub
+   * communities get a contiguous range of ids.
+   *
+   * Time complexity: O(|E|) per level of merges in practice
+   * Space complexity: O(|V| + |E|)
+   */
+  vector<int> community_order() const {
+    const int n = N();
+    vector<vector<pair<int, long long>>> adj(n);  // (vertex, weight)
+    vector<long long> deg(n);
+    double m2 = 0;
+    for (int u = 0; u < n; ++u)
+      for (int v : g()[u])
+        if (u != v) {
+          adj[u].push_back({v, 1});
+          adj[v].push_back({u, 1});
+          ++deg[u], ++deg[v], m2 += 2;
+        }
+
+    vector<int> by_deg(n), parent(n);
+    iota(by_deg.begin(), by_deg.end(), 0);
+    stable_sort(by_deg.begin(), by_deg.end(),
+                [&deg](int a, int b) { return deg[a] < deg[b]; });
+    iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](int x) {  // community, with path halving
+      while (parent[x] != x) x = parent[x] = parent[parent[x]];
+      return x;
+    };
+    vector<vector<int>> children(n);
+    vector<char> visited(n);
+    vector<long long> acc(n);
+    vector<int> touched;
+    for (int u : by_deg) {
+      visited[u] = true;
+      touched.clear();
+      for (auto [x, w] : adj[u]) {
+        int c = find(x);
+        if (c == u) continue;
+        if (acc[c] == 0) touched.push_back(c);
+        acc[c] += w;
+      }
+      adj[u].clear();
+      int best = -1;
+      double best_dq = 0;
+      for (int c : touched) {
+        double dq = 2 * (acc[c] / m2 - deg[u] * double(deg[c]) / (m2 * m2));
+        if (dq > best_dq) best_dq = dq, best = c;
+        adj[u].push_back({c, acc[c]});
+        acc[c] = 0;
+      }
+      if (best == -1) continue;  // u roots a community
+      parent[u] = best;
+      deg[best] += deg[u];
+      children[best].push_back(u);
+      if (!visited[best])
+        adj[best].insert(adj[best].end(), adj[u].begin(), adj[u].end());
+      vector<pair<int, long long>>().swap(adj[u]);
+    }
+
+    vector<int> perm(n), st;
+    int next = 0;
+    for (int r = 0; r < n; ++r) {
+      if (parent[r] != r) continue;
+      st = {r};
+      while (!st.empty()) {  // preorder, children in merge order
+        int x = st.back();
+        st.pop_back();
+        perm[x] = next++;
+        st.insert(st.end(), children[x].rbegin(), children[x].rend());
+      }
+    }
+    return perm;
+  }
+
+  /*
+   * Strongly connected components, iterative Tarjan
+   *
+   * Components are numbered in the order they are completed, a reverse
+   * topological order of the condensation: an edge between components goes
+   * from the higher id to the lower one
+   *
+   * Time complexity: O(|V|+|E|)
+   * Space complexity: O(|V|)
+   */
+  vector<int> strongly_connected_components() const {
+    vector<int> comp(N(), -1), idx(N(), -1), low(N()), st;
+    vector<pair<int, int>> frames;  // (vertex, index of its next edge)
+    int t = 0, cnt = 0;
+    auto discover = [&](int v) {
+      idx[v] = low[v] = t++;
+      st.push_back(v);
+      frames.push_back({v, 0});
+    };
+    for (int s = 0; s < N(); ++s) {
+      if (idx[s] != -1) continue;
+      discover(s);
+      while (!frames.empty()) {
+        auto [v, i] = frames.back();
+        auto const& nb = g()[v];
+        if (i < (int)nb.size()) {
+          ++frames.back().second;
+          int w = nb[i];
+          if (idx[w] == -1)
+            discover(w);
+          else if (comp[w] == -1)  // on the stack
+            low[v] = min(low[v], idx[w]);
+          continue;
+        }
+        frames.pop_back();
+        if (!frames.empty()) {
+          int p = frames.back().first;
+          low[p] = min(low[p], low[v]);
+        }
+        if (low[v] == idx[v]) {
+          int w;
+          do {
+            w = st.back();
+            st.pop_back();
+            comp[w] = cnt;
+          } while (w != v);
+          ++cnt;
+        }
+      }
+    }
+    return comp;
+  }
+
+  /*
+   * Strongly connected components in parallel (Slota, Rajamanickam,
+   * Madduri. BFS and Coloring-based Parallel Algorithms for Strongly
+   * Connected Components and Related Problems, IPDPS 2014)
+   *
+   * 1. trim: a vertex without incoming or outgoing edges (self loops aside)
+   *    is a component by itself. Atomic degree counters, level-synchronous
+   *    like topological_levels, so chains are trimmed in O(|V| + |E|)
+   * 2. forward-backward: the vertices both reachable from and reaching a
+   *    pivot of high degree (likely in the giant component) are its
+   *    component; two parallel BFS
+   * 3. coloring: every remaining vertex takes the largest id reaching it
+   *    (max propagation to a fixpoint). A vertex r keeping its own color
+   *    is a root: its component is what reaches r within color r, one
+   *    backward search per root, the roots in parallel. Repeat on the
+   *    vertices left.
+   *
+   * Components are numbered in order of their smallest vertex (unlike
+   * strongly_connected_components)
+   *
+   * Time complexity: O(|V| + |E|) for trim and forward-backward, O(|E|) per
+   * coloring round
+   * Space complexity: O(|V| + |E|) (the in-edges are copied)
+   */
+  vector<int> parallel_scc(int nthreads = 0) const {
+    constexpr int Grain = 1024;
+    nthreads = num_threads(nthreads);
+    const int n = N();
+    vector<int> roff(n + 1), rsrc;  // in-edges
+    for (int u = 0; u < n; ++u)
+      for (int v : g()[u]) ++roff[v + 1];
+    for (int u = 0; u < n; ++u) roff[u + 1] += roff[u];
+    rsrc.resize(roff[n]);
+    {
+      auto pos = roff;
+      for (int u = 0; u < n; ++u)
+        for (int v : g()[u]) rsrc[pos[v]++] = u;
+    }
+
+    vector<int> label(n, -1);  // a representative vertex of the component
+    vector<atomic<char>> done(n);
+    auto is_done = [&done](int v) {
+      return done[v].load(memory_order_relaxed) != 0;
+    };
+    vector<vector<int>> next(nthreads);
+    // level-synchronous: f(u, nx) visits u and pushes the next level to nx
+    auto expand = [&](vector<int> front, auto f) {
+      while (!front.empty()) {
+        const int m = front.size();
+        int nt = m < Grain ? 1 : nthreads;
+        run_threads(nt, [&](int t) {
+          next[t].clear();
+          for (int q = (long long)m * t / nt, e = (long long)m * (t + 1) / nt;
+               q < e; ++q)
+            f(front[q], next[t]);
+        });
+        front.clear();
+        for (int t = 0; t < nt; ++t)
+          front.insert(front.end(), next[t].begin(), next[t].end());
+      }
+    };
+
+    // 1. trim
+    vector<atomic<int>> in_cnt(n), out_cnt(n);
+    parallel_for(
+        0, n,
+        [&](int u) {
+          int c = 0;
+          for (int v : g()[u])
+            if (v != u) ++c, in_cnt[v].fetch_add(1, memory_order_relaxed);
+          out_cnt[u].store(c, memory_order_relaxed);
+        },
+        nthreads);
+    vector<int> front;
+    for (int u = 0; u < n; ++u)
+      if (in_cnt[u].load() == 0 || out_cnt[u].load() == 0) {
+        done[u].store(1, memory_order_relaxed);
+        front.push_back(u);
+      }
+    expand(front, [&](int u, vector<int>& nx) {
+      label[u] = u;
+      auto drop = [&](atomic<int>& cnt, int w) {
+        if (w != u && cnt.fetch_sub(1, memory_order_relaxed) == 1 &&
+            !done[w].exchange(1, memory_order_relaxed))
+          nx.push_back(w);
+      };
+      for (int v : g()[u]) drop(in_cnt[v], v);
+      for (int e = roff[u]; e < roff[u + 1]; ++e)
+        drop(out_cnt[rsrc[e]], rsrc[e]);
+    });
+
+    vector<int> act;  // vertices left
+    for (int u = 0; u < n; ++u)
+      if (!is_done(u)) act.push_back(u);
+    if (act.empty()) return renumber(label);
+
+    // 2. forward-backward from the pivot
+    int pivot = act[0];
+    long long best = -1;
+    for (int u : act) {
+      long long d = (long long)in_cnt[u].load() * out_cnt[u].load();
+      if (d > best) best = d, pivot = u;
+    }
+    vector<atomic<char>> seen(n);  // bit 0: forward, bit 1: backward
+    seen[pivot] = 3;
+    expand({pivot}, [&](int u, vector<int>& nx) {
+      for (int v : g()[u])
+        if (!is_done(v) && !(seen[v].fetch_or(1, memory_order_relaxed) & 1))
+          nx.push_back(v);
+    });
+    expand({pivot}, [&](int u, vector<int>& nx) {
+      for (int e = roff[u]; e < roff[u + 1]; ++e) {
+        int w = rsrc[e];
+        if (!is_done(w) && !(seen[w].fetch_or(2, memory_order_relaxed) & 2))
+          nx.push_back(w);
+      }
+    });
+    for (int u : act)
+      if (seen[u].load(memory_order_relaxed) == 3) label[u] = pivot;
+
+    // 3. coloring
+    vector<atomic<int>> color(n);
+    vector<int> roots;
+    while (true) {
+      act.erase(remove_if(act.begin(), act.end(),
+                          [&](int u) {
+                            if (label[u] == -1) return false;
+                            done[u].store(1, memory_order_relaxed);
+                            return true;
+                          }),
+                act.end());
+      if (act.empty()) break;
+      const int m = act.size();
+      int nt = m < Grain ? 1 : nthreads;
+      for (int u : act) color[u].store(u, memory_order_relaxed);
+      atomic<bool> changed{true};
+      while (changed) {
+        changed = false;
+        parallel_for(
+            0, m,
+            [&](int q) {
+              int u = act[q], c = color[u].load(memory_order_relaxed);
+              for (int v : g()[u]) {
+                if (is_done(v)) continue;
+                int old = color[v].load(memory_order_relaxed);
+                while (old < c && !color[v].compare_exchange_weak(
+                                      old, c, memory_order_relaxed))
+                  ;
+                if (old < c) changed.store(true, memory_order_relaxed);
+              }
+            },
+            nt);
+      }
+
+      roots.clear();
+      for (int u : act)
+        if (color[u].load(memory_order_relaxed) == u) roots.push_back(u);
+      const int r = roots.size();
+      nt = r < Grain ? 1 : nthreads;
+      run_threads(nt, [&](int t) {
+        vector<int> st;
+        for (int q = (long long)r * t / nt, e = (long long)r * (t + 1) / nt;
+             q < e; ++q) {
+          int c = roots[q];
+          label[c] = c;
+          st = {c};
+          while (!st.empty()) {
+            int x = st.back();
+            st.pop_back();
+            for (int e = roff[x]; e < roff[x + 1]; ++e) {
+              int w = rsrc[e];
+              if (color[w].load(memory_order_relaxed) == c &&
+                  !is_done(w) && label[w] == -1) {
+                label[w] = c;
+                st.push_back(w);
+              }
+            }
+          }
+        }
+      });
+    }
+    return renumber(label);
+  }
+
+  /*
+   * The DAG of the components comp (from strongly_connected_components or
+   * parallel_scc): an edge c -> d for every pair of components linked by
+   * at least one edge, no duplicates or self loops. Out is AdjList<> by
+   * default, ready for topological_sort.
+   *
+   * Time complexity: O(|V|+|E|)
+   */
+  template <typename Out = AdjList<>>
+  Out condense(vector<int> const& comp) const {
+    const int C = N() ? *max_element(comp.begin(), comp.end()) + 1 : 0;
+    vector<int> off(C + 1), by_comp(N()), last(C, -1);
+    for (int u = 0; u < N(); ++u) ++off[comp[u] + 1];
+    for (int c = 0; c < C; ++c) off[c + 1] += off[c];
+    {
+      auto pos = off;
+      for (int u = 0; u < N(); ++u) by_comp[pos[comp[u]]++] = u;
+    }
+    Out res(C);
+    for (int c = 0; c < C; ++c)
+      for (int q = off[c]; q < off[c + 1]; ++q)
+        for (int v : g()[by_comp[q]]) {
+          int d = comp[v];
+          if (d == c || last[d] == c) continue;
+          last[d] = c;
+          res[c].push_back(d);
+        }
+    return res;
+  }
+
+  /*
+   * All-pairs reachability: test(u, v) <=> a path of length >= 1 from u to v
+   *
+   * 1. condense the strongly connected components into a DAG
+   * 2. full[c] = members(c) | the vertices reachable from c, as a bitset
+   *    row: the OR of full[d] over the successors d of c. Components are
+   *    processed by levels (longest path to a sink), the components of a
+   *    large enough level in parallel
+   * 3. the row of u is full[comp(u)], without u itself if its component is a
+   *    single vertex without a self loop
+   *
+   * Time complexity: O(|V| + |E| |V| / 64) work
+   * Space complexity: O(|V|^2 / 64)
+   */
+  BitAdjMat reachability(int nthreads = 0) const {
+    constexpr int Grain = 256;  // components per level worth the threads
+    nthreads = num_threads(nthreads);
+    auto comp = strongly_connected_components();
+    const int C = N() ? *max_element(comp.begin(), comp.end()) + 1 : 0;
+    vector<int> off(C + 1), by_comp(N());
+    for (int u = 0; u < N(); ++u) ++off[comp[u] + 1];
+    for (int c = 0; c < C; ++c) off[c + 1] += off[c];
+    {
+      auto pos = off;
+      for (int u = 0; u < N(); ++u) by_comp[pos[comp[u]]++] = u;
+    }
+
+    vector<char> cyclic(C);
+    vector<int> level(C, 0);
+    for (int c = 0; c < C; ++c) {  // successors have lower ids
+      cyclic[c] = off[c + 1] - off[c] > 1;
+      for (int q = off[c]; q < off[c + 1]; ++q)
+        for (int v : g()[by_comp[q]]) {
+          if (comp[v] == c)
+            cyclic[c] = true;
+          else
+            level[c] = max(level[c], level[comp[v]] + 1);
+        }
+    }
+    vector<vector<int>> levels;
+    for (int c = 0; c < C; ++c) {
+      if (level[c] >= (int)levels.size()) levels.resize(level[c] + 1);
+      levels[level[c]].push_back(c);
+    }
+
+    BitAdjMat res(N());
+    const int W = res.words();
+    vector<uint64_t> full(size_t(C) * W);
+    for (auto const& lv : levels)
+      parallel_for(
+          0, (int)lv.size(),
+          [&](int q) {
+            int c = lv[q];
+            uint64_t* r = full.data() + size_t(c) * W;
+            for (int e = off[c]; e < off[c + 1]; ++e) {
+              int u = by_comp[e];
+              r[u >> 6] |= uint64_t(1) << (u & 63);
+              for (int v : g()[u]) {
+                if (comp[v] == c) continue;
+                uint64_t const* s = full.data() + size_t(comp[v]) * W;
+                for (int w = 0; w < W; ++w) r[w] |= s[w];
+              }
+            }
+          },
+          lv.size() < Grain ? 1 : nthreads);
+    parallel_for(
+        0, N(),
+        [&](int u) {
+          copy_n(full.data() + size_t(comp[u]) * W, W, res.row(u));
+          if (!cyclic[comp[u]]) res.set(u, u, false);
+        },
+        nthreads);
+    return res;
+  }
+
+  /*
+   * All-pairs shortest paths, blocked Floyd-Warshall
+   *
+   * Weighted graphs only (neighbors are WeightedNode). Negative edges are
+   * allowed, negative cycles are not; distances are INF when unreachable and
+   * path weights must stay within (-INF / 2, INF / 2).
+   *
+   * The matrix is cut into Tile x Tile blocks (16 KB, fits in L1). Round kb
+   * relaxes through the vertices of block kb:
+   * 1. the diagonal block (kb, kb)
+   * 2. the blocks of row kb and of column kb, which only depend on it
+   * 3. every other block (i, j), from (i, kb) and (kb, j)
+   * Steps 2 and 3 run in parallel over row blocks. The inner loop is a min
+   * over contiguous ints, which the compiler vectorizes.
+   *
+   * Time complexity: O(|V|^3) work
+   * Space complexity: O(|V|^2)
+   */
+  AdjMat floyd_warshall(int nthreads = 0) const {
+    constexpr int Tile = 64;
+    nthreads = num_threads(nthreads);
+    const int n = N();
+    AdjMat d(n);
+    fill_n(d.row(0), size_t(d.N) * d.N, INF);
+    for (int u = 0; u < n; ++u) {
+      d[{u, u}] = 0;
+      for (auto [v, w] : g()[u]) d[{u, v}] = min(d[{u, v}], w);
+    }
+
+    const int B = (n + Tile - 1) / Tile;
+    // d[i][j] = min(d[i][j], d[i][k] + d[k][j]) for i, j, k in the blocks
+    auto relax = [&d, n](int bi, int bj, int bk) {
+      const int ie = min(n, (bi + 1) * Tile), je = min(n, (bj + 1) * Tile);
+      const int ke = min(n, (bk + 1) * Tile), j0 = bj * Tile;
+      for (int k = bk * Tile; k < ke; ++k) {
+        int const* dk = d.row(k);
+        for (int i = bi * Tile; i < ie; ++i) {
+          int* di = d.row(i);
+          const int dik = di[k];
+          // row k itself is a no-op without negative cycles (d[k][k] = 0)
+          if (i == k || dik > INF / 2) continue;
+          if (je - j0 == Tile)
+            relax_row<Tile>(di + j0, dk + j0, dik, Tile);
+          else
+            relax_row<0>(di + j0, dk + j0, dik, je - j0);
+        }
+      }
+    };
+    for (int k = 0; k < B; ++k) {
+      relax(k, k, k);
+      parallel_for(
+          0, B,
+          [&](int b) {
+            if (b == k) return;
+            relax(k, b, k);
+            relax(b, k, k);
+          },
+          nthreads);
+      parallel_for(
+          0, B,
+          [&](int i) {
+            if (i == k) return;
+            for (int j = 0; j < B; ++j)
+              if (j != k) relax(i, j, k);
+          },
+          nthreads);
+    }
+    for (int u = 0; u < n; ++u)
+      for (int v = 0; v < n; ++v)
+        if (d[{u, v}] > INF / 2) d[{u, v}] = INF;
+    return d;
+  }
+
+  /*
+   * Minimum spanning forests
+   *
+   * Weighted undirected graphs only: neighbors are WeightedNode and every
+   * edge is stored in both directions. Self loops are ignored, weights may
+   * be negative.
+   *
+   * kruskal and boruvka break ties between equal weights by the order of
+   * the edges (u < v) in the adjacency lists, so they return the same edge
+   * set; prim may pick other edges of the same total weight.
+   */
+
+  /*
+   * Edges sorted by weight with two stable counting sort passes of 16 bits
+   * (an LSD radix sort), then added through a DSUF unless they close a cycle
+   *
+   * Time complexity: O(|E| alpha(|V|))
+   * Space complexity: O(|E|)
+   */
+  SpanningForest kruskal() const {
+    auto es = undirected_edges();
+    vector<tuple<int, int, int>> tmp(es.size());
+    auto key = [](auto const& e) { return uint32_t(get<2>(e)) ^ 0x80000000; };
+    counting_sort(es.begin(), es.end(), tmp.begin(),
+                  [&](auto const& e) { return uint16_t(key(e)); });
+    counting_sort(tmp.begin(), tmp.end(), es.begin(),
+                  [&](auto const& e) { return uint16_t(key(e) >> 16); });
+
+    SpanningForest res;
+    DSUF dsuf(N());
+    for (auto const& [u, v, w] : es) {
+      if ((int)res.edges.size() == N() - 1) break;
+      if (dsuf.same_set(u, v)) continue;
+      dsuf.uni(u, v);
+      res.weight += w;
+      res.edges.push_back({u, v, w});
+    }
+    return res;
+  }
+
+  /*
+   * Prim with an IndexedDaryHeap keyed by the lightest edge into the tree,
+   * restarted from every vertex not reached yet
+   *
+   * Time complexity: O(|E| log_4 |V|)
+   * Space complexity: O(|V|)
+   */
+  SpanningForest prim() const {
+    SpanningForest res;
+    IndexedDaryHeap<> q(N());
+    vector<int> from(N(), -1);
+    vector<char> in_tree(N());
+    for (int s = 0; s < N(); ++s) {
+      if (in_tree[s]) continue;
+      q.push(s, 0);
+      while (!q.empty()) {
+        auto [w, u] = q.pop();
+        in_tree[u] = true;
+        if (from[u] != -1) {
+          res.weight += w;
+          res.edges.push_back({min(u, from[u]), max(u, from[u]), w});
+        }
+        for (auto [v, wv] : g()[u])
+          if (!in_tree[v] && (!q.contains(v) || wv < q.key(v))) {
+            from[v] = u;
+            q.push(v, wv);
+          }
+      }
+    }
+    return res;
+  }
+
+  /*
+   * Parallel Boruvka: every round, each component picks its lightest
+   * outgoing edge (an atomic min over 64-bit keys: weight, then edge index,
+   * so there are no ties), the picked edges are united in a ConcurrentDSUF,
+   * and the edges inside a component are filtered out. The components at
+   * least halve every round.
+   *
+   * Time complexity: O((|V| + |E|) log |V|) work
+   * Space complexity: O(|V| + |E|)
+   */
+  SpanningForest boruvka(int nthreads = 0) const {
+    constexpr int Grain = 1 << 14;
+    constexpr uint64_t None = UINT64_MAX;
+    nthreads = num_threads(nthreads);
+    const auto es = undirected_edges();
+    auto key = [&es](int e) {
+      return uint64_t(uint32_t(get<2>(es[e])) ^ 0x80000000) << 32 | e;
+    };
+    auto split = [](int m, int t, int nt, auto f) {
+      for (int q = (long long)m * t / nt, e = (long long)m * (t + 1) / nt;
+           q < e; ++q)
+        f(q);
+    };
+
+    ConcurrentDSUF dsuf(N());
+    vector<atomic<uint64_t>> best(N());
+    for (auto& b : best) b.store(None, memory_order_relaxed);
+    vector<int> cur(es.size());
+    iota(cur.begin(), cur.end(), 0);
+    vector<vector<int>> part(nthreads);
+    vector<vector<tuple<int, int, int>>> picked(nthreads);
+    SpanningForest res;
+    while (!cur.empty()) {
+      const int m = cur.size();
+      int nt = m < Grain ? 1 : nthreads;
+      run_threads(nt, [&](int t) {
+        split(m, t, nt, [&](int q) {
+          auto [u, v, w] = es[cur[q]];
+          uint64_t k = key(cur[q]);
+          for (int r : {dsuf.root(u), dsuf.root(v)}) {
+            uint64_t old = best[r].load(memory_order_relaxed);
+            while (k < old && !best[r].compare_exchange_weak(
+                                  old, k, memory_order_relaxed))
+              ;
+          }
+        });
+      });
+      run_threads(nt, [&](int t) {
+        split(N(), t, nt, [&](int r) {
+          uint64_t k = best[r].load(memory_order_relaxed);
+          if (k == None) return;
+          best[r].store(None, memory_order_relaxed);
+          auto [u, v, w] = es[uint32_t(k)];
+          if (dsuf.uni(u, v)) picked[t].push_back({u, v, w});
+        });
+      });
+      run_threads(nt, [&](int t) {
+        part[t].clear();
+        split(m, t, nt, [&](int q) {
+          auto [u, v, w] = es[cur[q]];
+          if (dsuf.root(u) != dsuf.root(v)) part[t].push_back(cur[q]);
+        });
+      });
+      cur.clear();
+      for (int t = 0; t < nt; ++t)
+        cur.insert(cur.end(), part[t].begin(), part[t].end());
+      for (auto& p : picked) {
+        for (auto const& e : p) {
+          res.weight += get<2>(e);
+          res.edges.push_back(e);
+        }
+        p.clear();
+      }
+    }
+    return res;
+  }
 
   /*
+   * Weighted graphs only (neighbors are WeightedNode)
+   *
    * Precondition: There are no negative edges
    *
    * Time complexity: O(|E|log|V|)
-   *
-   * note 1: At most |E| duplicates of vertices so the complexity
-   *            is still O(|E|log|V|)
    */
   vector<int> dijkstra(Node root) const {
-    vector<int> dis(N(), INF);
-    vector<int> done(N());
+    DijkstraWorkspace<> ws;
+    dijkstra(ws, root);
+    return move(ws.dis);
+  }
+
+  /*
+   * Shortest paths from root into ws (ws.dis, ws.pred, ws.path)
+   *
+   * Time complexity: O(|E|log_4|V|) with the default IndexedDaryHeap
+   */
+  template <typename Queue>
+  void dijkstra(DijkstraWorkspace<Queue>& ws, Node root) const {
+    dijkstra(ws, root, -1);
+  }
+
+  /*
+   * Stop as soon as target is settled and return its distance (INF if
+   * unreachable)
+   *
+   * ws.dis and ws.pred are final for target and every vertex closer than it,
+   * tentative for the others
+   */
+  template <typename Queue>
+  int dijkstra(DijkstraWorkspace<Queue>& ws, Node root, int target) const {
+    ws.reset(N());
+    ws.relax(root, 0, -1);
+    while (!ws.q.empty()) {
+      auto [d, u] = ws.q.pop();
+      if (d > ws.dis[u]) continue;  // stale entry of a monotone queue
+      if (u == target) return d;
+      for (auto [v, w] : g()[u])
+        if (d + w < ws.dis[v]) ws.relax(v, d + w, u);
+    }
+    return INF;
+  }
+
+  /*
+   * Parallel single source shortest paths by delta-stepping, same result as
+   * dijkstra(root)
+   * (Meyer, Sanders. Delta-stepping: a parallelizable shortest path
+   * algorithm, J. Algorithms 2003)
+   *
+   * Vertices are kept in buckets of tentative distance width delta (0: chosen
+   * from the largest weight and the average degree). The smallest non-empty
+   * bucket is emptied by rounds of relaxing its light edges (w <= delta),
+   * which may refill it, in parallel over its vertices; then the heavy edges
+   * of every vertex settled in the bucket are relaxed once. Distances are
+   * lowered with an atomic min. Every thread keeps its own buckets, a
+   * circular array of maxw / delta + 2 of them (the tentative distances in
+   * the queue span at most maxw + delta). A delta so small that this would
+   * exceed MaxBuckets is raised to about maxw / MaxBuckets, which only costs
+   * more light-edge rounds.
+   *
+   * Precondition: There are no negative edges
+   *
+   * Time complexity: O(|V| + |E| + L / delta) expected work for random
+   * weights and delta about maxw / average degree, L the largest distance
+   */
+  vector<int> delta_stepping(Node root, int delta = 0, int nthreads = 0) const {
+    constexpr int Grain = 256;
+    constexpr long long MaxBuckets = 1 << 16;
+    nthreads = num_threads(nthreads);
+    long long maxw = 0, m = 0;
+    for (int u = 0; u < N(); ++u)
+      for (auto [_, w] : g()[u]) maxw = max<long long>(maxw, w), ++m;
+    if (delta <= 0) delta = max<long long>(1, maxw * N() / max(m, 1LL));
+    if (maxw / delta + 2 > MaxBuckets)
+      delta = (maxw + MaxBuckets - 3) / (MaxBuckets - 2);
+    const int B = maxw / delta + 2;
+
+    vector<atomic<int>> dis(N());
+    vector<atomic<int>> stamp(N());  // last bucket a vertex was settled in
+    for (int u = 0; u < N(); ++u) {
+      dis[u].store(INF, memory_order_relaxed);
+      stamp[u].store(-1, memory_order_relaxed);
+    }
+    vector<vector<vector<int>>> bins(nthreads, vector<vector<int>>(B));
+    vector<vector<int>> settled(nthreads);
+    vector<int> front{root}, done;
     dis[root] = 0;
 
-    using E = pair<int, Node>;  // distance, node
-    priority_queue<E, vector<E>, greater<E>> q;
-    q.push({0, root});
+    // f(tid, u) for u in vs
+    auto parallel = [&](vector<int> const& vs, auto f) {
+      const int n = vs.size();
+      int nt = n < Grain ? 1 : nthreads;
+      run_threads(nt, [&](int t) {
+        for (int q = (long long)n * t / nt, e = (long long)n * (t + 1) / nt;
+             q < e; ++q)
+          f(t, vs[q]);
+      });
+    };
+    auto relax = [&](int t, int v, int nd) {
+      int old = dis[v].load(memory_order_relaxed);
+      while (nd < old)
+        if (dis[v].compare_exchange_weak(old, nd, memory_order_relaxed)) {
+          bins[t][nd / delta % B].push_back(v);
+          return;
+        }
+    };
+    auto gather = [&](int b, vector<int>& out) {  // move bucket b into out
+      out.clear();
+      for (auto& tb : bins) {
+        out.insert(out.end(), tb[b % B].begin(), tb[b % B].end());
+        tb[b % B].clear();
+      }
+    };
+
+    for (int cur = 0;;) {
+      while (!front.empty()) {  // light edges, until the bucket stays empty
+        parallel(front, [&](int t, int u) {
+          int d = dis[u].load(memory_order_relaxed);
+          if (d / delta != cur) return;  // stale: lowered to a former bucket
+          if (stamp[u].exchange(cur, memory_order_relaxed) != cur)
+            settled[t].push_back(u);
+          for (auto [v, w] : g()[u])
+            if (w <= delta) relax(t, v, d + w);
+        });
+        gather(cur, front);
+      }
+      done.clear();
+      for (auto& s : settled) {
+        done.insert(done.end(), s.begin(), s.end());
+        s.clear();
+      }
+      parallel(done, [&](int t, int u) {  // heavy edges
+        int d = dis[u].load(memory_order_relaxed);
+        for (auto [v, w] : g()[u])
+          if (w > delta) relax(t, v, d + w);
+      });
 
-    while (!q.empty()) {
-      auto [_, u] = q.top(); // distance is smallest in q
-      q.pop();
-      if (done[u]) continue;
-      done[u] = true;
-      for (auto [v, w] : (*this)[u])
-        if (dis[u] + w < dis[v])
-          q.push({dis[v] = dis[u] + w, v});  // see note 1
+      int next = -1;  // smallest non-empty bucket
+      for (int b = cur + 1; b < cur + B && next == -1; ++b)
+        for (auto& tb : bins)
+          if (!tb[b % B].empty()) next = b;
+      if (next == -1) break;
+      cur = next;
+      gather(cur, front);
+    }
+
+    vector<int> res(N());
+    for (int u = 0; u < N(); ++u) res[u] = dis[u].load(memory_order_relaxed);
+    return res;
+  }
+
+  /*
+   * A* search from root to target, return the distance (INF if unreachable)
+   *
+   * h(v): lower bound of the distance from v to target (admissible), INF if
+   * v cannot reach target. With a consistent h (h(u) <= w(u, v) + h(v))
+   * every vertex is settled at most once and the queue keys are monotone, so
+   * RadixHeap works too; an admissible but inconsistent h needs
+   * IndexedDaryHeap (vertices may be settled again). h = 0 is dijkstra with
+   * early exit
+   *
+   * Time complexity: O(|E|log|V|) worst case, usually far fewer vertices are
+   * settled than with dijkstra
+   */
+  template <typename Queue, typename H>
+  int astar(DijkstraWorkspace<Queue>& ws, Node root, int target, H h) const {
+    ws.reset(N());
+    ws.relax(root, 0, -1, h(root));
+    while (!ws.q.empty()) {
+      auto [key, u] = ws.q.pop();
+      int d = ws.dis[u];
+      if (key > d + h(u)) continue;  // stale entry of a monotone queue
+      if (u == target) return d;
+      for (auto [v, w] : g()[u])
+        if (d + w < ws.dis[v]) ws.relax(v, d + w, u, d + w + h(v));
+    }
+    return INF;
+  }
+
+  /*
+   * Bidirectional Dijkstra from root to target, return the distance (INF if
+   * unreachable)
+   *
+   * rev: the transpose of this graph (see transpose()); the same graph for
+   * undirected graphs
+   *
+   * Expands the side with the smaller queue head; every relaxed edge whose
+   * head was reached by the other side gives a candidate mu. Stops when the
+   * heads of both queues sum to at least mu.
+   */
+  int bidirectional_dijkstra(G const& rev, BidirectionalWorkspace& ws,
+                             Node root, int target) const {
+    auto& f = ws.fwd;
+    auto& b = ws.bwd;
+    f.reset(N());
+    b.reset(N());
+    f.relax(root, 0, -1);
+    b.relax(target, 0, -1);
+    int mu = INF;
+    ws.meet = -1;
+    if (int(root) == target) ws.meet = target, mu = 0;
+    auto head = [](auto& side) {
+      return side.q.empty() ? INF : side.q.top().first;
+    };
+    while (head(f) + head(b) < mu) {
+      bool forward = head(f) <= head(b);
+      auto& side = forward ? f : b;
+      auto& other = forward ? b : f;
+      auto [d, u] = side.q.pop();
+      auto scan = [&](auto const& graph) {
+        for (auto [v, w] : graph[u]) {
+          if (d + w < side.dis[v]) side.relax(v, d + w, u);
+          if (other.dis[v] != INF && side.dis[v] + other.dis[v] < mu)
+            mu = side.dis[v] + other.dis[v], ws.meet = v;
+        }
+      };
+      if (forward)
+        scan(g());
+      else
+        scan(rev);
+    }
+    if (mu == INF) ws.meet = -1;
+    return mu;
+  }
+
+ protected:
+  G const& g() const { return static_cast<G const&>(*this); }
+  int N() const { return g().N(); }
+
+  // (u, v, w) with u < v for the weighted undirected graphs, adjacency order
+  vector<tuple<int, int, int>> undirected_edges() const {
+    vector<tuple<int, int, int>> es;
+    for (int u = 0; u < N(); ++u)
+      for (auto [v, w] : g()[u])
+        if (u < v) es.push_back({u, v, w});
+    return es;
+  }
+
+  // representative vertices to ids 0, 1, 2... in order of first occurrence
+  static vector<int> renumber(vector<int> label) {
+    vector<int> id(label.size(), -1);
+    int cnt = 0;
+    for (auto& x : label) {
+      if (id[x] == -1) id[x] = cnt++;
+      x = id[x];
     }
-    return dis;
+    return label;
+  }
+
+  /*
+   * di[j] = min(di[j], dik + dk[j]) for j < (Len ? Len : len), di and dk
+   * distinct rows. A constant Len (full tiles) lets -O2 vectorize the loop.
+   */
+  template <int Len>
+  static void relax_row(int* __restrict di, int const* __restrict dk, int dik,
+                        int len) {
+    const int e = Len ? Len : len;
+    for (int j = 0; j < e; ++j) di[j] = min(di[j], dik + dk[j]);
+  }
+};
+
+/*
+ * ALT lower bounds for astar (A*, Landmarks, Triangle inequality)
+ * Goldberg, Harrelson. Computing the Shortest Path: A* Search Meets Graph
+ * Theory (SODA 2005)
+ *
+ * For every landmark l, by the triangle inequality
+ *   d(v, t) >= d(l, t) - d(l, v)  and  d(v, t) >= d(v, l) - d(t, l)
+ * The distances from and to the k landmarks are stored contiguously per
+ * vertex, so a bound reads two rows of k ints. The bound is consistent.
+ *
+ * Space complexity: O(k|V|)
+ * Time complexity:
+ * - build: 2k dijkstra runs
+ * - bound: O(k)
+ */
+class AltHeuristic {
+ public:
+  // rev: the transpose of g
+  template <typename G, typename R>
+  AltHeuristic(G const& g, R const& rev, vector<int> const& landmarks)
+      : k(landmarks.size()), from(size_t(g.N()) * k), to(size_t(g.N()) * k) {
+    DijkstraWorkspace<> ws;
+    for (int l = 0; l < k; ++l) {
+      g.dijkstra(ws, landmarks[l]);
+      for (int v = 0; v < g.N(); ++v) from[size_t(v) * k + l] = ws.dis[v];
+      rev.dijkstra(ws, landmarks[l]);
+      for (int v = 0; v < g.N(); ++v) to[size_t(v) * k + l] = ws.dis[v];
+    }
+  }
+
+  /*
+   * k landmarks by farthest-point selection: each one is the vertex farthest
+   * (among the reachable ones) from those picked before, starting from first
+   */
+  template <typename G>
+  static vector<int> farthest_landmarks(G const& g, int k, int first = 0) {
+    vector<int> res, near(g.N(), INF);  // distance to the nearest landmark
+    DijkstraWorkspace<> ws;
+    for (int l = first; (int)res.size() < min(k, g.N());) {
+      res.push_back(l);
+      near[l] = 0;
+      g.dijkstra(ws, l);
+      for (int v = 0; v < g.N(); ++v) {
+        near[v] = min(near[v], ws.dis[v]);
+        if (near[v] != INF && near[v] > near[l]) l = v;
+      }
+      if (near[l] == 0) break;  // every reachable vertex is a landmark
+    }
+    return res;
+  }
+
+  // lower bound of d(v, t), INF if v cannot reach t
+  int operator()(int v, int t) const {
+    int best = 0;
+    auto fv = &from[size_t(v) * k], ft = &from[size_t(t) * k];
+    auto tv = &to[size_t(v) * k], tt = &to[size_t(t) * k];
+    for (int l = 0; l < k; ++l) {
+      // l reaches v but not t, or t reaches l but not v
+      if ((fv[l] != INF && ft[l] == INF) || (tt[l] != INF && tv[l] == INF))
+        return INF;
+      if (fv[l] != INF) best = max(best, ft[l] - fv[l]);
+      if (tt[l] != INF) best = max(best, tv[l] - tt[l]);
+    }
+    return best;
+  }
+
+ private:
+  int k;
+  vector<int> from;  // from[v * k + l] = d(landmark l, v)
+  vector<int> to;    // to[v * k + l] = d(v, landmark l)
+};
+
+/*
+ * Adjacency List
+ *
+ * Can be used for Directed/Undirected graph
+ *
+ * Space complexity: O(|V| + |E|)
+ * Time complexity:
+ * - Add vertex: O(1)
+ * - add edge: O(1)
+ * - remove edge: O(|V|)
+ * - query adjacency: O(|V|) for all the neighbors of a particular vertex
+ *
+ * To provide custom Dest Node, provide a conversion function to Node
+ * and a conversion function to int (for destination)
+ *
+ * Algorithms are in GraphAlgo; see CsrGraph (ds/csr_graph.hpp) for a static
+ * graph with contiguous adjacency
+ */
+template <typename Dest>
+struct AdjList : GraphAlgo<AdjList<Dest>> {
+  AdjList(int n) : neigh(n) {}
+  vector<Dest>& operator[](int x) { return neigh[x]; }
+  vector<Dest> const& operator[](int x) const { return neigh[x]; }
+  int N() const { return neigh.size(); }
+
+  /*
+   * The graph with every vertex v renamed perm[v], perm a permutation of
+   * [0, N()) (degree_order, rcm_order, community_order...)
+   *
+   * The lists are allocated by increasing new id, so that they also follow
+   * the new order in memory
+   *
+   * Time complexity: O(|V| + |E|)
+   */
+  AdjList relabeled(vector<int> const& perm) const {
+    vector<int> inv(N());
+    for (int u = 0; u < N(); ++u) inv[perm[u]] = u;
+    AdjList res(N());
+    for (int x = 0; x < N(); ++x) {
+      auto& ls = res[x] = neigh[inv[x]];
+      for (auto& e : ls) e.val = perm[e.val];
+    }
+    return res;
+  }
+
+  /*
+   * In place: the neighbor lists are moved along the cycles of perm, each
+   * keeps its allocation (for the memory locality, relabeled or a CsrGraph
+   * of the result)
+   */
+  void relabel(vector<int> const& perm) {
+    for (auto& ls : neigh)
+      for (auto& e : ls) e.val = perm[e.val];
+    vector<char> done(N());
+    for (int s = 0; s < N(); ++s) {
+      if (done[s]) continue;
+      vector<Dest> cur = move(neigh[s]);
+      int x = s;
+      do {  // the list of x goes to perm[x]
+        x = perm[x];
+        swap(cur, neigh[x]);
+        done[x] = true;
+      } while (x != s);
+    }
+  }
+
+  // same graph with every edge reversed (Dest keeps its other fields)
+  AdjList transpose() const {
+    AdjList res(N());
+    for (int u = 0; u < N(); ++u)
+      for (Dest e : neigh[u]) {
+        int v = e;
+        e.val = u;
+        res[v].push_back(e);
+      }
+    return res;
+  }
+
+  using iterator = typename vector<vector<Dest>>::iterator;
+  using const_iterator = typename vector<vector<Dest>>::const_iterator;
+  iterator begin() { return neigh.begin(); }
+  iterator end() { return neigh.end(); }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator end() const { return cend(); }
+  const_iterator cbegin() const { return neigh.cbegin(); }
+  const_iterator cend() const { return neigh.cend(); }
+
+  friend ostream& operator<<(ostream& os, AdjList& al) {
+    for (int q = 0; q < al.N(); ++q) {
+      os << q << ": ";
+      int M = al[q].size();
+      for (int w = 0; w < M - 1; ++w) {
+        os << al[q][w] << ", ";
+      }
+      if (!al[q].empty()) os << al[q][M - 1];
+      os << '\n';
+    }
+    return os;
+  }
+
+ private:
+  vector<vector<Dest>> neigh;  // list of adjacent vertices
+};
+
+struct WeightedAdjList : public AdjList<WeightedNode> {
+  using Base = AdjList<WeightedNode>;
+  using Base::Base;
+};
+
+/*
+ * Result of FunctionalGraph::cycles: every vertex v reaches the cycle
+ * cycle[v] after tail[v] steps (0 on the cycle); the cycle c has len[c]
+ * vertices. Cycles are numbered in order of the smallest vertex reaching
+ * them.
+ */
+struct FunctionalCycles {
+  vector<int> cycle;
+  vector<int> tail;
+  vector<int> len;
+};
+
+/*
+ * k-th successor queries of FunctionalGraph::jump_table
+ *
+ * A jump that goes around the cycle is reduced to the tail onto the cycle
+ * plus (k - tail[v]) mod the cycle length, so no lookup is longer than
+ * |V| - 1 steps whatever k is; with max_k >= |V| every query is
+ * O(log |V|).
+ */
+struct FunctionalJumps {
+  BinaryLifting up;
+  FunctionalCycles cyc;
+
+  int levels() const { return up.levels(); }
+
+  // f^k(v), k >= 0
+  int jump(int v, long long k) const {
+    int t = cyc.tail[v], len = cyc.len[cyc.cycle[v]];
+    if (k - t >= len) {
+      v = up.jump(v, t);
+      k = (k - t) % len;
+    }
+    return up.jump(v, k);
   }
 };
 
@@ -388,7 +1998,9 @@ struct WeightedAdjList : public AdjList<WeightedNode> {
  */
 struct FunctionalGraph {
   FunctionalGraph(int n) : succ(n) {}
+  explicit FunctionalGraph(vector<int> f) : succ(move(f)) {}
   int& operator[](int x) { return succ[x]; }
+  int operator[](int x) const { return succ[x]; }
   int N() const { return succ.size(); }
 
   /*
@@ -422,6 +2034,171 @@ struct FunctionalGraph {
     return true;
   }
 
+  /*
+   * Cycle, tail length and cycle length of every vertex
+   *
+   * One walk per vertex not yet seen, marking its path until a vertex seen
+   * before: if it is on the path, the end of the path is a new cycle. The
+   * rest of the path is then filled backwards from the successors.
+   *
+   * Time complexity: O(|V|)
+   */
+  FunctionalCycles cycles() const {
+    const int n = N();
+    FunctionalCycles res{vector<int>(n), vector<int>(n, -1), {}};
+    auto& [cycle, tail, len] = res;
+    vector<int> path;
+    for (int s = 0; s < n; ++s) {
+      if (tail[s] != -1) continue;
+      path.clear();
+      int x = s;
+      for (; tail[x] == -1; x = succ[x]) {
+        tail[x] = -2;  // on the path
+        path.push_back(x);
+      }
+      size_t e = path.size();
+      if (tail[x] == -2) {  // x is on a new cycle
+        int c = len.size(), l = 0;
+        for (int y = x; tail[y] == -2; y = succ[y], ++l) {
+          tail[y] = 0;
+          cycle[y] = c;
+        }
+        len.push_back(l);
+        e -= l;  // the cycle ends the path
+      }
+      while (e-- > 0) {
+        int y = path[e];
+        tail[y] = tail[succ[y]] + 1;
+        cycle[y] = cycle[succ[y]];
+      }
+    }
+    return res;
+  }
+
+  /*
+   * cycles() by pointer jumping, same result
+   *
+   * 1. the cycle vertices are the images of f^|V| (successors)
+   * 2. list ranking (Wyllie) of the tails: every vertex doubles its jump
+   *    towards the cycle and adds up the distances, until all jumps land on
+   *    a cycle
+   * 3. every cycle vertex takes the minimum of its cycle over windows of
+   *    doubling length, which identifies the cycle
+   *
+   * Time complexity: O(|V| log |V| / threads)
+   * Space complexity: O(|V|)
+   */
+  FunctionalCycles parallel_cycles(int nthreads = 0) const {
+    constexpr int Grain = 1 << 16;
+    const int n = N();
+    nthreads = n < Grain ? 1 : num_threads(nthreads);
+    auto pfor = [nthreads](int lo, int hi, auto f) {
+      parallel_for(lo, hi, f, nthreads);
+    };
+
+    vector<atomic<char>> on(n);
+    {
+      auto far = successors(n, nthreads);
+      pfor(0, n, [&](int v) { on[far[v]].store(1, memory_order_relaxed); });
+    }
+    vector<int> cyc;  // cycle vertices
+    for (int v = 0; v < n; ++v)
+      if (on[v].load(memory_order_relaxed)) cyc.push_back(v);
+
+    vector<int> root(n), dist(n), nroot(n), ndist(n);
+    pfor(0, n, [&](int v) {
+      bool c = on[v].load(memory_order_relaxed);
+      root[v] = c ? v : succ[v];
+      dist[v] = !c;
+    });
+    atomic<bool> more = true;
+    while (more.exchange(false)) {
+      pfor(0, n, [&](int v) {
+        int r = root[v];
+        nroot[v] = root[r];
+        ndist[v] = dist[v] + dist[r];
+        if (!on[nroot[v]].load(memory_order_relaxed))
+          more.store(true, memory_order_relaxed);
+      });
+      swap(root, nroot);
+      swap(dist, ndist);
+    }
+
+    // minimum of the cycle, indexed like cyc
+    const int m = cyc.size();
+    vector<int> at(n), mn(m), jmp(m), nmn(m), njmp(m);
+    pfor(0, m, [&](int i) { at[cyc[i]] = i; });
+    pfor(0, m, [&](int i) {
+      mn[i] = cyc[i];
+      jmp[i] = at[succ[cyc[i]]];
+    });
+    for (long long w = 1; w < m; w *= 2) {
+      pfor(0, m, [&](int i) {
+        nmn[i] = min(mn[i], mn[jmp[i]]);
+        njmp[i] = jmp[jmp[i]];
+      });
+      swap(mn, nmn);
+      swap(jmp, njmp);
+    }
+
+    // number the cycles by the smallest vertex reaching them
+    vector<atomic<int>> first(n), cnt(n);
+    pfor(0, m, [&](int i) {
+      first[mn[i]].store(n, memory_order_relaxed);
+      cnt[mn[i]].fetch_add(1, memory_order_relaxed);
+    });
+    pfor(0, n, [&](int v) {
+      auto& f = first[mn[at[root[v]]]];
+      for (int x = f.load(memory_order_relaxed);
+           v < x && !f.compare_exchange_weak(x, v, memory_order_relaxed);) {
+      }
+    });
+    vector<int> owner(n, -1), id(n);
+    pfor(0, m, [&](int i) {
+      if (mn[i] == cyc[i]) owner[first[cyc[i]].load()] = cyc[i];
+    });
+    FunctionalCycles res{vector<int>(n), move(dist), {}};
+    for (int v = 0; v < n; ++v)
+      if (owner[v] != -1) {
+        id[owner[v]] = res.len.size();
+        res.len.push_back(cnt[owner[v]].load());
+      }
+    pfor(0, n, [&](int v) { res.cycle[v] = id[mn[at[root[v]]]]; });
+    return res;
+  }
+
+  /*
+   * f^k(v) for every vertex v, by repeated squaring of f
+   *
+   * Time complexity: O(|V| log k / threads)
+   */
+  vector<int> successors(long long k, int nthreads = 0) const {
+    constexpr int Grain = 1 << 16;
+    const int n = N();
+    nthreads = n < Grain ? 1 : nthreads;
+    vector<int> res(n), p = succ, np(n);
+    iota(res.begin(), res.end(), 0);
+    for (; k; k >>= 1) {
+      if (k & 1)
+        parallel_for(0, n, [&](int v) { res[v] = p[res[v]]; }, nthreads);
+      if (k == 1) break;
+      parallel_for(0, n, [&](int v) { np[v] = p[p[v]]; }, nthreads);
+      swap(p, np);
+    }
+    return res;
+  }
+
+  /*
+   * k-th successor queries for any k, with a lifting table of jumps up to
+   * max_k and cycles() to reduce longer ones
+   *
+   * Time complexity: O(|V| log max_k / threads + |V|), then O(log k) per
+   * query for k <= max_k (any k if max_k >= |V|)
+   */
+  FunctionalJumps jump_table(long long max_k, int nthreads = 0) const {
+    return {BinaryLifting(succ, max_k, nthreads), cycles()};
+  }
+
  private:
   vector<int> succ;
 };
@@ -0,0 +1,285 @@
+#ifndef GRAPH_IO_HPP
+#define GRAPH_IO_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ds/csr_graph.hpp"
+#include "ds/graph.hpp"
+#include "util/file.hpp"
+#include "util/mapped_file.hpp"
+#include "util/parallel.hpp"
+
+/*
+ * Loading graphs from files
+ *
+ * Text formats, memory mapped and parsed in parallel chunks of whole lines:
+ * - edge list: "u v" per line, "u v w" for WeightedNode
+ * - adjacency: "u: a, b, c" per line, as read by scripts/graph.py
+ * Blank lines and lines starting with '#' or '%' are skipped; the number of
+ * vertices is the largest id + 1. A malformed line throws invalid_argument.
+ *
+ * Binary format: save_csr_graph writes the arrays of a CsrGraph, which
+ * MappedCsrGraph uses in place from the mapping (zero-copy, native byte
+ * order)
+ */
+namespace P {
+using namespace std;
+
+/*
+ * Parse a decimal int at p after spaces and tabs, false if there is none
+ */
+inline bool parse_int(char const*& p, char const* e, int& x) {
+  while (p < e && (*p == ' ' || *p == '\t')) ++p;
+  bool neg = p < e && *p == '-';
+  if (neg) ++p;
+  if (p == e || *p < '0' || *p > '9') return false;
+  int v = 0;
+  for (; p < e && *p >= '0' && *p <= '9'; ++p) {
+    if (v > (INT_MAX - (*p - '0')) / 10) return false;  // overflow
+    v = v * 10 + (*p - '0');
+  }
+  x = neg ? -v : v;
+  return true;
+}
+
+// a vertex id, below INT_MAX so that the number of vertices is an int
+inline bool is_vertex(int x) { return 0 <= x && x < INT_MAX; }
+
+/*
+ * Split the file into one chunk of whole lines per thread (at least Grain
+ * bytes each) and call parse(b, e, edges, maxv) on every line [b, e)
+ * without its end of line and leading blanks. edges and maxv (the largest
+ * vertex seen) belong to the thread; parse returns false on a bad line.
+ */
+template <typename Dest, typename F>
+vector<vector<pair<int, Dest>>> parse_lines(string const& path, int nthreads,
+                                            int& n, F parse) {
+  constexpr size_t Grain = 1 << 20;
+  MappedFile f(path);
+  f.advise(MADV_SEQUENTIAL);
+  char const* data = f.data();
+  const size_t size = f.size();
+  const int nt = clamp<size_t>(size / Grain, 1, num_threads(nthreads));
+  auto line_start = [&](size_t i) -> size_t {  // first one at or after i
+    if (i == 0) return 0;
+    auto nl = memchr(data + i - 1, '\n', size - i + 1);
+    return nl ? static_cast<char const*>(nl) - data + 1 : size;
+  };
+
+  vector<vector<pair<int, Dest>>> parts(nt);
+  vector<int> maxv(nt, -1);
+  vector<size_t> bad(nt, SIZE_MAX);
+  run_threads(nt, [&](int t) {
+    char const* p = data + line_start(size * t / nt);
+    char const* end = data + line_start(size * (t + 1) / nt);
+    while (p < end) {
+      auto nl = static_cast<char const*>(memchr(p, '\n', end - p));
+      char const* le = nl ? nl : end;
+      char const* b = p;
+      while (b < le && (*b == ' ' || *b == '\t')) ++b;
+      char const* e = le > b && le[-1] == '\r' ? le - 1 : le;
+      if (b < e && *b != '#' && *b != '%' &&
+          !parse(b, e, parts[t], maxv[t])) {
+        bad[t] = p - data;
+        return;
+      }
+      p = le + 1;
+    }
+  });
+  for (int t = 0; t < nt; ++t)
+    if (bad[t] != SIZE_MAX)
+      throw invalid_argument(path + ": bad line at byte " +
+                             to_string(bad[t]));
+  n = *max_element(maxv.begin(), maxv.end()) + 1;
+  return parts;
+}
+
+/*
+ * AdjList of n vertices from per-thread edge lists, neighbors in file
+ * order. The degrees are counted in parallel, then every neighbor vector is
+ * allocated once at its final size before the edges are appended.
+ */
+template <typename Dest>
+AdjList<Dest> build_adjlist(int n, vector<vector<pair<int, Dest>>> const& parts,
+                            int nthreads = 0) {
+  vector<atomic<int>> deg(n);
+  run_threads(parts.size(), [&](int t) {
+    for (auto const& e : parts[t])
+      deg[e.first].fetch_add(1, memory_order_relaxed);
+  });
+  AdjList<Dest> al(n);
+  parallel_for(
+      0, n, [&](int u) { al[u].reserve(deg[u].load(memory_order_relaxed)); },
+      nthreads);
+  for (auto const& part : parts)
+    for (auto const& [u, d] : part) al[u].push_back(d);
+  return al;
+}
+
+/*
+ * Time complexity: O(size / threads + |V| + |E|)
+ */
+template <typename Dest = Node>
+AdjList<Dest> load_edge_list(string const& path, int nthreads = 0) {
+  static_assert(is_same_v<Dest, Node> || is_same_v<Dest, WeightedNode>);
+  int n;
+  auto parts = parse_lines<Dest>(
+      path, nthreads, n,
+      [](char const* p, char const* e, auto& edges, int& maxv) {
+        int u, v, w = 0;
+        if (!parse_int(p, e, u) || !parse_int(p, e, v) || !is_vertex(u) ||
+            !is_vertex(v))
+          return false;
+        if constexpr (is_same_v<Dest, WeightedNode>) {
+          if (!parse_int(p, e, w)) return false;
+          edges.push_back({u, {v, w}});
+        } else {
+          edges.push_back({u, v});
+        }
+        while (p < e && (*p == ' ' || *p == '\t')) ++p;
+        if (p != e) return false;  // trailing junk
+        maxv = max({maxv, u, v});
+        return true;
+      });
+  return build_adjlist(n, parts, nthreads);
+}
+
+/*
+ * "u: a, b, c" lines; "u:" declares u without neighbors
+ *
+ * Time complexity: O(size / threads + |V| + |E|)
+ */
+inline AdjList<> load_adjacency(string const& path, int nthreads = 0) {
+  int n;
+  auto parts = parse_lines<Node>(
+      path, nthreads, n,
+      [](char const* p, char const* e, auto& edges, int& maxv) {
+        int u, v;
+        if (!parse_int(p, e, u) || !is_vertex(u)) return false;
+        while (p < e && *p == ' ') ++p;
+        if (p == e || *p++ != ':') return false;
+        maxv = max(maxv, u);
+        while (parse_int(p, e, v)) {
+          if (!is_vertex(v)) return false;
+          edges.push_back({u, v});
+          maxv = max(maxv, v);
+          while (p < e && (*p == ' ' || *p == '\t')) ++p;
+          if (p < e && *p == ',') ++p;
+        }
+        while (p < e && (*p == ' ' || *p == '\t')) ++p;
+        return p == e;
+      });
+  return build_adjlist(n, parts, nthreads);
+}
+
+/*
+ * Header of the binary graph files
+ */
+struct CsrFileHeader {
+  static constexpr char Magic[8] = {'P', 'D', 'S', 'G', 'R', '0', '0', '1'};
+
+  char magic[8];
+  uint64_t n, m;
+  uint64_t weighted;
+};
+
+/*
+ * Header, then the offsets (n + 1 ints), targets (m ints) and, if weighted,
+ * weights (m ints) of g
+ */
+template <typename Dest>
+void save_csr_graph(CsrGraph<Dest> const& g, string const& path) {
+  static_assert(is_same_v<Dest, Node> || is_same_v<Dest, WeightedNode>);
+  CsrFileHeader h{};
+  memcpy(h.magic, CsrFileHeader::Magic, sizeof(h.magic));
+  h.n = g.N();
+  h.m = g.M();
+  h.weighted = CsrGraph<Dest>::Weighted;
+  auto f = open_file(path, "wb");
+  write_values(f.get(), &h, 1);
+  write_values(f.get(), g.offsets().data(), h.n + 1);
+  write_values(f.get(), g.targets().data(), h.m);  // Node is a single int
+  if (h.weighted) write_values(f.get(), g.weights().data(), h.m);
+  if (fflush(f.get())) throw system_error(errno, generic_category(), path);
+}
+
+/*
+ * Static graph read in place from a file of save_csr_graph: opening it maps
+ * the file and checks the header and sizes, then pages are loaded on
+ * demand as the graph is traversed
+ *
+ * check: also verify that the offsets are non-decreasing and the targets
+ * are vertices, so that a corrupt file cannot make traversals read out of
+ * bounds. Pass false only for trusted files, to skip reading them whole.
+ *
+ * Same algorithms as AdjList (GraphAlgo)
+ *
+ * Time complexity: O(|V| + |E|) to open, O(1) without check (only the
+ * header and two offsets are read)
+ */
+template <typename Dest = Node>
+struct MappedCsrGraph : GraphAlgo<MappedCsrGraph<Dest>> {
+  static_assert(is_same_v<Dest, Node> || is_same_v<Dest, WeightedNode>);
+  static constexpr bool Weighted = is_same_v<Dest, WeightedNode>;
+
+  explicit MappedCsrGraph(string const& path, bool check = true)
+      : file(path) {
+    CsrFileHeader h;
+    if (file.size() < sizeof(h))
+      throw invalid_argument(path + ": not a graph file");
+    memcpy(&h, file.data(), sizeof(h));
+    if (memcmp(h.magic, CsrFileHeader::Magic, sizeof(h.magic)))
+      throw invalid_argument(path + ": not a graph file");
+    if (h.weighted != Weighted)
+      throw invalid_argument(path + ": weighted graph mismatch");
+    uint64_t ints = h.n + 1 + h.m * (1 + Weighted);
+    if (h.n >= INT_MAX || h.m > INT_MAX ||
+        file.size() != sizeof(h) + sizeof(int) * ints)
+      throw invalid_argument(path + ": corrupt graph file");
+    n = h.n;
+    off = reinterpret_cast<int const*>(file.data() + sizeof(h));
+    dst = off + n + 1;
+    w = dst + h.m;
+    if (off[0] != 0 || off[n] != (int)h.m)
+      throw invalid_argument(path + ": corrupt graph file");
+    if (!check) return;
+    for (int u = 0; u < n; ++u)
+      if (off[u] > off[u + 1])
+        throw invalid_argument(path + ": corrupt graph file");
+    for (int i = 0; i < (int)h.m; ++i)
+      if (dst[i] < 0 || dst[i] >= n)
+        throw invalid_argument(path + ": corrupt graph file");
+  }
+
+  int N() const { return n; }
+  int M() const { return off[n]; }
+
+  auto operator[](int u) const {
+    int b = off[u], e = off[u + 1];
+    if constexpr (Weighted)
+      return NeighborRange<WeightedNodeIt>{{dst + b, w + b}, {dst + e, w + e}};
+    else
+      return NeighborRange<int const*>{dst + b, dst + e};
+  }
+
+ private:
+  MappedFile file;
+  int n;
+  int const* off;  // neighbors of u: [off[u], off[u + 1])
+  int const* dst;  // destinations
+  int const* w;    // weights, only when Weighted
+};
+
+}  // namespace P
+#endif /* GRAPH_IO_HPP */
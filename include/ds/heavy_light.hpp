@@ -0,0 +1,121 @@
+#ifndef HEAVY_LIGHT_HPP
+#define HEAVY_LIGHT_HPP
+
+#include <utility>
+#include <vector>
+
+#include "ds/lca.hpp"
+
+namespace P {
+using namespace std;
+
+/*
+ * Heavy-light decomposition of a directed tree (edges parent -> child)
+ *
+ * Every vertex continues the path of its parent if it is its child with
+ * the largest subtree (heavy), else it starts a new path. Vertices get
+ * positions in a DFS order taking the heavy child first, so that every
+ * heavy path and every subtree is a contiguous range of positions. A path
+ * between two vertices crosses O(log |V|) heavy paths: lay out the vertex
+ * values by position (by_position) in any range structure (prefix sums,
+ * segment tree...) and aggregate over the ranges given by path.
+ *
+ * Space complexity: O(|V|)
+ * Time complexity:
+ * - construction: O(|V|), no recursion
+ * - lca, path: O(log |V|) ranges
+ * - subtree: O(1)
+ */
+class HeavyLight {
+ public:
+  HeavyLight() = default;
+
+  template <typename G>
+  HeavyLight(G const& g, int root) : HeavyLight(RootedTree(g, root)) {}
+
+  explicit HeavyLight(RootedTree const& t)
+      : par(t.parent), dep(t.depth), pos(t.N()), sz(t.N(), 1), hop(t.N()) {
+    const int n = t.N();
+    auto const& order = t.order;
+    vector<int> heavy(n, -1), next(n), head(n);
+    for (int i = n - 1; i > 0; --i) {  // children before parents
+      int v = order[i], p = par[v];
+      if (heavy[p] == -1 || sz[v] > sz[heavy[p]]) heavy[p] = v;
+      sz[p] += sz[v];
+    }
+    // next[v]: position of the next light child of v
+    for (int i = 0; i < n; ++i) {
+      int v = order[i], p = par[v];
+      if (i == 0) {
+        pos[v] = 0;
+        head[v] = v;
+      } else if (heavy[p] == v) {
+        pos[v] = pos[p] + 1;
+        head[v] = head[p];
+      } else {
+        pos[v] = next[p];
+        next[p] += sz[v];
+        head[v] = v;
+      }
+      next[v] = pos[v] + 1 + (heavy[v] == -1 ? 0 : sz[heavy[v]]);
+    }
+    for (int v = 0; v < n; ++v) hop[v] = {head[v], par[head[v]], dep[head[v]]};
+  }
+
+  int N() const { return par.size(); }
+  int parent(int v) const { return par[v]; }
+  int depth(int v) const { return dep[v]; }
+  int position(int v) const { return pos[v]; }
+
+  // positions [b, e) of the subtree of v
+  pair<int, int> subtree(int v) const { return {pos[v], pos[v] + sz[v]}; }
+
+  int lca(int u, int v) const {
+    for (; hop[u].head != hop[v].head; u = hop[u].up)
+      if (hop[u].depth < hop[v].depth) swap(u, v);
+    return dep[u] < dep[v] ? u : v;
+  }
+
+  int dist(int u, int v) const { return dep[u] + dep[v] - 2 * dep[lca(u, v)]; }
+
+  /*
+   * f(b, e) for ranges of positions [b, e) covering the vertices of the
+   * path between u and v, in no particular order (for commutative
+   * aggregates). With edges, the value of an edge is that of its child
+   * vertex and the lca is left out.
+   */
+  template <typename F>
+  void path(int u, int v, F f, bool edges = false) const {
+    for (; hop[u].head != hop[v].head; u = hop[u].up) {
+      if (hop[u].depth < hop[v].depth) swap(u, v);
+      f(pos[hop[u].head], pos[u] + 1);
+    }
+    if (dep[u] > dep[v]) swap(u, v);
+    if (pos[u] + edges <= pos[v]) f(pos[u] + edges, pos[v] + 1);
+  }
+
+  // values by vertex -> values by position
+  template <typename T>
+  vector<T> by_position(vector<T> const& val) const {
+    vector<T> res(val.size());
+    for (int v = 0; v < N(); ++v) res[pos[v]] = val[v];
+    return res;
+  }
+
+ private:
+  // all that a step of the climb in lca and path reads, side by side
+  struct Hop {
+    int head;   // first vertex of the heavy path
+    int up;     // parent of head
+    int depth;  // of head
+  };
+
+  vector<int> par;  // par[root] = root
+  vector<int> dep;  // depth
+  vector<int> pos;  // position
+  vector<int> sz;   // subtree size
+  vector<Hop> hop;
+};
+
+}  // namespace P
+#endif /* HEAVY_LIGHT_HPP */
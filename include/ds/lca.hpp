@@ -0,0 +1,269 @@
+#ifndef LCA_HPP
+#define LCA_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ds/binary_lifting.hpp"
+#include "ds/dsuf.hpp"
+
+/*
+ * Lowest common ancestors in a directed tree: edges parent -> child, every
+ * vertex reached from the root (AdjList, CsrGraph... see dfs_dtree)
+ *
+ * - EulerTourLca: O(1) queries, O(|V|) space
+ * - BinaryLiftingLca: O(log |V|) queries, also k-th ancestors
+ * - tarjan_lca: a batch of queries known in advance, one traversal
+ *
+ * Everything is iterative, trees as deep as |V| are fine.
+ */
+namespace P {
+using namespace std;
+
+/*
+ * Parent, depth and preorder of every vertex of a directed tree, by an
+ * iterative DFS from root (children in reverse order)
+ *
+ * Throw invalid_argument if a vertex is reached twice or not at all
+ *
+ * Time complexity: O(|V|)
+ */
+struct RootedTree {
+  RootedTree() = default;
+
+  template <typename G>
+  RootedTree(G const& g, int root) : parent(g.N(), -1), depth(g.N()) {
+    const int n = g.N();
+    if (n == 0) return;
+    order.reserve(n);
+    vector<int> st{root};
+    parent[root] = root;
+    while (!st.empty()) {
+      int u = st.back();
+      st.pop_back();
+      order.push_back(u);
+      for (int v : g[u]) {
+        if (parent[v] != -1) throw invalid_argument("RootedTree: not a tree");
+        parent[v] = u;
+        depth[v] = depth[u] + 1;
+        st.push_back(v);
+      }
+    }
+    if ((int)order.size() != n)
+      throw invalid_argument("RootedTree: not a tree");
+  }
+
+  int N() const { return parent.size(); }
+
+  vector<int> parent;  // parent[root] = root
+  vector<int> depth;
+  vector<int> order;  // preorder, every subtree contiguous
+};
+
+/*
+ * LCA by range minimum over the Euler tour, in its preorder form: for
+ * tin[u] < tin[v], the vertices of preorder positions (tin[u], tin[v]]
+ * contain a child of lca(u, v) on the way to v, and no vertex above it, so
+ * the smallest tin[parent[x]] over the range is tin[lca(u, v)]. That is
+ * |V| - 1 entries instead of the 2 |V| - 1 of the full tour.
+ *
+ * Range minimum in O(1) without a sparse table per element: a sparse table
+ * over blocks of 64 entries, and inside a block, for every position r, a
+ * 64-bit mask of the entries that are the minimum of a suffix ending at r
+ * (a monotonic stack); the minimum of [l, r] is the lowest bit >= l.
+ *
+ * Space complexity: O(|V|), 24 bytes per vertex and the block table
+ * Time complexity:
+ * - construction: O(|V|)
+ * - lca: O(1), a handful of cache misses
+ */
+class EulerTourLca {
+ public:
+  EulerTourLca() = default;
+
+  template <typename G>
+  EulerTourLca(G const& g, int root) : EulerTourLca(RootedTree(g, root)) {}
+
+  explicit EulerTourLca(RootedTree const& t)
+      : order(t.order), tin(t.N()), depth(t.depth), a(t.N()), mask(t.N()) {
+    const int n = t.N();
+    for (int i = 0; i < n; ++i) tin[order[i]] = i;
+    for (int i = 1; i < n; ++i) a[i] = tin[t.parent[order[i]]];
+    for (int b = 0; b < n; b += 64) {
+      uint64_t st = 0;
+      for (int i = b; i < min(n, b + 64); ++i) {
+        while (st && a[b + top(st)] >= a[i]) st ^= uint64_t(1) << top(st);
+        mask[i] = st |= uint64_t(1) << (i - b);
+      }
+    }
+
+    const int nb = (n + 63) / 64;
+    table.emplace_back(nb);
+    for (int b = 0; b < nb; ++b)
+      table[0][b] = *min_element(a.begin() + b * 64,
+                                 a.begin() + min(n, b * 64 + 64));
+    for (int k = 1; (1 << k) <= nb; ++k) {
+      auto const& prev = table[k - 1];
+      vector<int> cur(nb - (1 << k) + 1);
+      for (int b = 0; b < (int)cur.size(); ++b)
+        cur[b] = min(prev[b], prev[b + (1 << (k - 1))]);
+      table.push_back(move(cur));
+    }
+  }
+
+  int N() const { return order.size(); }
+
+  int lca(int u, int v) const {
+    if (u == v) return u;
+    int l = tin[u], r = tin[v];
+    if (l > r) swap(l, r);
+    return order[range_min(l + 1, r)];
+  }
+
+  // number of edges between u and v
+  int dist(int u, int v) const {
+    return depth[u] + depth[v] - 2 * depth[lca(u, v)];
+  }
+
+ private:
+  static int top(uint64_t x) { return 63 - __builtin_clzll(x); }
+
+  // minimum of a[l..r] inside one block
+  int in_block(int l, int r) const {
+    auto m = mask[r] & (~uint64_t(0) << (l & 63));
+    return a[(r & ~63) + __builtin_ctzll(m)];
+  }
+
+  int range_min(int l, int r) const {
+    int bl = l >> 6, br = r >> 6;
+    if (bl == br) return in_block(l, r);
+    int res = min(in_block(l, bl << 6 | 63), in_block(br << 6, r));
+    if (bl + 1 < br) {
+      int k = 31 - __builtin_clz(br - bl - 1);
+      res = min({res, table[k][bl + 1], table[k][br - (1 << k)]});
+    }
+    return res;
+  }
+
+  vector<int> order;  // preorder
+  vector<int> tin;    // position in order
+  vector<int> depth;
+  vector<int> a;          // a[i] = tin[parent[order[i]]]
+  vector<uint64_t> mask;  // suffix minima of a in the block, up to i
+  vector<vector<int>> table;  // table[k][b]: min of blocks [b, b + 2^k)
+};
+
+/*
+ * LCA by binary lifting over the parents: lift the deeper vertex to the
+ * depth of the other, then both by decreasing powers of two while they
+ * differ
+ *
+ * Space complexity: O(|V| log(height))
+ * Time complexity:
+ * - construction: O(|V| log(height) / threads)
+ * - lca, ancestor: O(log(height))
+ */
+class BinaryLiftingLca {
+ public:
+  BinaryLiftingLca() = default;
+
+  template <typename G>
+  BinaryLiftingLca(G const& g, int root, int nthreads = 0)
+      : BinaryLiftingLca(RootedTree(g, root), nthreads) {}
+
+  explicit BinaryLiftingLca(RootedTree const& t, int nthreads = 0)
+      : depth(t.depth),
+        up(t.parent,
+           t.N() ? *max_element(t.depth.begin(), t.depth.end()) : 0,
+           nthreads) {}
+
+  int N() const { return depth.size(); }
+
+  // the k-th ancestor of v, the root if k >= depth(v)
+  int ancestor(int v, int k) const { return up.jump(v, min(k, depth[v])); }
+
+  int lca(int u, int v) const {
+    if (depth[u] < depth[v]) swap(u, v);
+    u = up.jump(u, depth[u] - depth[v]);
+    if (u == v) return u;
+    for (int j = up.levels() - 1; j >= 0; --j) {
+      int const* p = up.up(j);
+      if (p[u] != p[v]) u = p[u], v = p[v];
+    }
+    return up.up(0, u);
+  }
+
+  int dist(int u, int v) const {
+    return depth[u] + depth[v] - 2 * depth[lca(u, v)];
+  }
+
+ private:
+  vector<int> depth;
+  BinaryLifting up;  // over the parents
+};
+
+/*
+ * Offline LCA of every query (u, v), Tarjan's algorithm
+ *
+ * One iterative DFS; a finished vertex is merged into the set of its
+ * parent, whose ancestor is the parent. On entering u, the queries (u, w)
+ * with w already entered are answered by the ancestor of the set of w: the
+ * deepest vertex on the current path that w descends from.
+ *
+ * Precondition: g is a directed tree from root
+ *
+ * Time complexity: O((|V| + |Q|) alpha(|V|))
+ * Space complexity: O(|V| + |Q|)
+ */
+template <typename G>
+vector<int> tarjan_lca(G const& g, int root,
+                       vector<pair<int, int>> const& queries) {
+  const int n = g.N(), q = queries.size();
+  vector<int> start(n + 1), at(2 * q);  // queries of each vertex, CSR
+  for (auto [u, v] : queries) ++start[u + 1], ++start[v + 1];
+  for (int u = 0; u < n; ++u) start[u + 1] += start[u];
+  {
+    auto pos = start;
+    for (int i = 0; i < q; ++i) {
+      at[pos[queries[i].first]++] = i;
+      at[pos[queries[i].second]++] = i;
+    }
+  }
+
+  vector<int> res(q, -1), anc(n);
+  vector<char> entered(n);
+  DSUF dsu(n);
+  vector<pair<int, int>> st;  // (vertex, next child)
+  auto enter = [&](int u) {
+    entered[u] = true;
+    anc[u] = u;
+    for (int i = start[u]; i < start[u + 1]; ++i) {
+      auto [a, b] = queries[at[i]];
+      int w = a == u ? b : a;
+      if (entered[w] && res[at[i]] == -1) res[at[i]] = anc[dsu.root(w)];
+    }
+    st.push_back({u, 0});
+  };
+  if (n > 0) enter(root);
+  while (!st.empty()) {
+    auto [u, i] = st.back();
+    if (i == (int)g[u].size()) {
+      st.pop_back();
+      if (!st.empty()) {
+        int p = st.back().first;
+        dsu.uni(p, u);
+        anc[dsu.root(p)] = p;
+      }
+      continue;
+    }
+    ++st.back().second;
+    enter(g[u][i]);
+  }
+  return res;
+}
+
+}  // namespace P
+#endif /* LCA_HPP */
@@ -0,0 +1,122 @@
+#ifndef MONOTONE_QUEUE_HPP
+#define MONOTONE_QUEUE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/*
+ * Monotone priority queues of (key, item) with non-negative int keys
+ *
+ * Monotone: a pushed key is never smaller than the last popped key, which is
+ * the case for the tentative distances of Dijkstra's algorithm. There is no
+ * decrease-key; push the item again and skip the stale entry when popped.
+ *
+ * Same interface as IndexedDaryHeap (clear(n), empty, push, pop) so they can
+ * be used as the queue of a DijkstraWorkspace
+ */
+namespace P {
+using namespace std;
+
+/*
+ * Radix heap
+ *
+ * Bucket 0 holds the keys equal to the last popped key, bucket i > 0 the keys
+ * whose highest bit differing from it is bit i - 1. pop refills bucket 0 from
+ * the first non-empty bucket: its minimum becomes the new last key, and every
+ * entry moves to a strictly lower bucket.
+ *
+ * Time complexity: O(1) push, O(log C) amortized pop where C is the largest
+ * key
+ */
+class RadixHeap {
+ public:
+  RadixHeap(int = 0) {}
+
+  void clear(int = 0) {
+    for (auto& b : buckets) b.clear();
+    last = 0;
+    cnt = 0;
+  }
+
+  bool empty() const { return cnt == 0; }
+  int size() const { return cnt; }
+
+  // Precondition: key >= the last popped key
+  void push(int v, int key) {
+    buckets[bucket(key)].push_back({uint32_t(key), v});
+    ++cnt;
+  }
+
+  pair<int, int> pop() {
+    if (buckets[0].empty()) {
+      int i = 1;
+      while (buckets[i].empty()) ++i;
+      last = min_element(buckets[i].begin(), buckets[i].end())->first;
+      for (auto e : buckets[i]) buckets[bucket(e.first)].push_back(e);
+      buckets[i].clear();
+    }
+    auto [key, v] = buckets[0].back();
+    buckets[0].pop_back();
+    --cnt;
+    return {int(key), v};
+  }
+
+ private:
+  int bucket(uint32_t key) const {
+    return key == last ? 0 : 32 - __builtin_clz(key ^ last);
+  }
+
+  array<vector<pair<uint32_t, int>>, 33> buckets;
+  uint32_t last = 0;
+  int cnt = 0;
+};
+
+/*
+ * Dial's bucket queue for keys spread over at most max_spread + 1 values at
+ * any time, e.g. Dijkstra with edge weights in [0, max_spread]
+ *
+ * A circular array of max_spread + 1 buckets indexed by key; pop scans
+ * forward from the last popped key.
+ *
+ * Time complexity: O(1) push, O(1) amortized pop plus the scan over empty
+ * buckets: O(|E| + |V| + D) for Dijkstra with D the largest distance
+ */
+class BucketQueue {
+ public:
+  BucketQueue(int max_spread = 1) : buckets(max_spread + 1) {}
+
+  void clear(int = 0) {
+    for (auto& b : buckets) b.clear();
+    cur = 0;
+    cnt = 0;
+  }
+
+  bool empty() const { return cnt == 0; }
+  int size() const { return cnt; }
+
+  // Precondition: last popped key <= key <= last popped key + max_spread
+  void push(int v, int key) {
+    buckets[key % buckets.size()].push_back(v);
+    ++cnt;
+  }
+
+  pair<int, int> pop() {
+    while (buckets[cur % buckets.size()].empty()) ++cur;
+    auto& b = buckets[cur % buckets.size()];
+    int v = b.back();
+    b.pop_back();
+    --cnt;
+    return {cur, v};
+  }
+
+ private:
+  vector<vector<int>> buckets;
+  int cur = 0;  // last popped key
+  int cnt = 0;
+};
+
+}  // namespace P
+#endif /* MONOTONE_QUEUE_HPP */
@@ -0,0 +1,171 @@
+#ifndef ROLLBACK_DSUF_HPP
+#define ROLLBACK_DSUF_HPP
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace P {
+using namespace std;
+
+/*
+ * Disjoint Set Union Find with rollback
+ *
+ * Union by size and no path compression, so every union changes exactly two
+ * entries of p and can be undone from a log of (child, old p[child])
+ *
+ * snapshot() returns a position in the log; rollback(to) undoes every union
+ * done after it, in reverse order
+ *
+ * Time complexity:
+ * - root / same_set / uni: O(log n)
+ * - rollback: O(1) per undone union
+ */
+class RollbackDSUF {
+ public:
+  RollbackDSUF(int n) : p(n, -1), sets(n) {}
+
+  int root(int i) const {
+    while (p[i] >= 0) i = p[i];
+    return i;
+  }
+
+  bool same_set(int i, int j) const { return root(i) == root(j); }
+
+  /*
+   * Return false (and log nothing) if u and v were already in the same set
+   */
+  bool uni(int u, int v) {
+    u = root(u);
+    v = root(v);
+    if (u == v) return false;
+    if (p[u] > p[v]) swap(u, v);
+    undo_log.push_back({v, p[v]});
+    p[u] += p[v];
+    p[v] = u;
+    --sets;
+    return true;
+  }
+
+  int size(int u) const { return -p[root(u)]; }
+  int count() const { return sets; }  // number of sets
+
+  size_t snapshot() const { return undo_log.size(); }
+
+  void rollback(size_t to) {
+    while (undo_log.size() > to) {
+      auto [v, pv] = undo_log.back();
+      undo_log.pop_back();
+      p[p[v]] -= pv;
+      p[v] = pv;
+      ++sets;
+    }
+  }
+
+ private:
+  vector<int> p;  // parents (and negative size for roots)
+  int sets;
+  vector<pair<int, int>> undo_log;  // (linked root, its old p)
+};
+
+/*
+ * Offline dynamic connectivity
+ *
+ * Record a sequence of add_edge / remove_edge / query operations, then solve
+ * answers every query at once.
+ *
+ * Every edge is alive over an interval of operation indices. The interval is
+ * stored in the O(log T) nodes of a segment tree over time that cover it; a
+ * DFS of the tree unions the edges of a node on the way down and rolls them
+ * back on the way up, so at leaf t exactly the edges alive at time t are
+ * united.
+ *
+ * Time complexity: O(T log T log n) for T operations
+ */
+class DynamicConnectivity {
+ public:
+  DynamicConnectivity(int n) : n(n) {}
+
+  void add_edge(int u, int v) {
+    alive[key(u, v)].push_back(ops.size());
+    ops.push_back({ADD, u, v});
+  }
+
+  // Precondition: (u, v) was added and not removed since
+  void remove_edge(int u, int v) {
+    auto& starts = alive[key(u, v)];
+    edges.push_back({starts.back(), (int)ops.size(), u, v});
+    starts.pop_back();
+    ops.push_back({REMOVE, u, v});
+  }
+
+  // are u and v connected at this point of the sequence
+  void query(int u, int v) { ops.push_back({QUERY, u, v}); }
+
+  // answers to query() in order
+  vector<bool> solve() {
+    const int T = ops.size();
+    for (auto& [e, starts] : alive)
+      for (int s : starts) edges.push_back({s, T, e.first, e.second});
+    alive.clear();
+    if (T == 0) return {};
+
+    seg.assign(4 * T, {});
+    for (int q = 0; q < (int)edges.size(); ++q)
+      insert(1, 0, T, edges[q].l, edges[q].r, q);
+
+    vector<bool> res;
+    RollbackDSUF d(n);
+    auto dfs_ = [this, &d, &res](int node, int lo, int hi,
+                                 auto dfs__) -> void {
+      auto snap = d.snapshot();
+      for (int q : seg[node]) d.uni(edges[q].u, edges[q].v);
+      if (hi - lo == 1) {
+        if (ops[lo].type == QUERY)
+          res.push_back(d.same_set(ops[lo].u, ops[lo].v));
+      } else {
+        int mid = (lo + hi) / 2;
+        dfs__(2 * node, lo, mid, dfs__);
+        dfs__(2 * node + 1, mid, hi, dfs__);
+      }
+      d.rollback(snap);
+    };
+    dfs_(1, 0, T, dfs_);
+    return res;
+  }
+
+ private:
+  enum OpType { ADD, REMOVE, QUERY };
+  struct Op {
+    OpType type;
+    int u, v;
+  };
+  struct Edge {
+    int l, r;  // alive on [l, r)
+    int u, v;
+  };
+
+  static pair<int, int> key(int u, int v) { return {min(u, v), max(u, v)}; }
+
+  // add edge q to the nodes covering [l, r) in node = [lo, hi)
+  void insert(int node, int lo, int hi, int l, int r, int q) {
+    if (r <= lo || hi <= l) return;
+    if (l <= lo && hi <= r) {
+      seg[node].push_back(q);
+      return;
+    }
+    int mid = (lo + hi) / 2;
+    insert(2 * node, lo, mid, l, r, q);
+    insert(2 * node + 1, mid, hi, l, r, q);
+  }
+
+  int n;
+  vector<Op> ops;
+  vector<Edge> edges;
+  map<pair<int, int>, vector<int>> alive;  // edge -> add times not removed
+  vector<vector<int>> seg;                 // segment tree over time
+};
+
+}  // namespace P
+#endif /* ROLLBACK_DSUF_HPP */
@@ -0,0 +1,86 @@
+#ifndef FILE_HPP
+#define FILE_HPP
+
+#include <stdlib.h>  // mkstemp
+#include <unistd.h>  // unlink, close
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+/*
+ * stdio helpers that report errors by throwing system_error (POSIX)
+ */
+namespace P {
+using namespace std;
+
+using FilePtr = unique_ptr<FILE, int (*)(FILE*)>;
+
+inline FilePtr open_file(string const& path, char const* mode) {
+  FilePtr f(fopen(path.c_str(), mode), fclose);
+  if (!f) throw system_error(errno, generic_category(), "open " + path);
+  return f;
+}
+
+/*
+ * Anonymous read/write file in dir
+ */
+inline FilePtr make_temp_file(string const& dir) {
+  string path = dir + "/pdsalgo_run_XXXXXX";
+  int fd = mkstemp(path.data());
+  if (fd < 0)
+    throw system_error(errno, generic_category(), "mkstemp " + path);
+  unlink(path.c_str());
+  FILE* f = fdopen(fd, "w+b");
+  if (!f) {
+    int e = errno;
+    close(fd);
+    throw system_error(e, generic_category(), "fdopen " + path);
+  }
+  return FilePtr(f, fclose);
+}
+
+/*
+ * Raw binary I/O of trivially copyable values (native byte order)
+ *
+ * read_values throws on a short read as well, so a truncated file is an error
+ */
+template <typename T>
+void write_values(FILE* f, T const* data, size_t n) {
+  static_assert(is_trivially_copyable_v<T>);
+  if (fwrite(data, sizeof(T), n, f) != n)
+    throw system_error(errno, generic_category(), "write");
+}
+
+template <typename T>
+void read_values(FILE* f, T* data, size_t n) {
+  static_assert(is_trivially_copyable_v<T>);
+  if (fread(data, sizeof(T), n, f) != n)
+    throw system_error(ferror(f) ? errno : int(errc::io_error),
+                       generic_category(), "read");
+}
+
+// size, then elements
+template <typename T>
+void write_vector(FILE* f, vector<T> const& v) {
+  uint64_t n = v.size();
+  write_values(f, &n, 1);
+  write_values(f, v.data(), n);
+}
+
+template <typename T>
+vector<T> read_vector(FILE* f) {
+  uint64_t n;
+  read_values(f, &n, 1);
+  vector<T> v(n);
+  read_values(f, v.data(), n);
+  return v;
+}
+
+}  // namespace P
+#endif /* FILE_HPP */
@@ -0,0 +1,54 @@
+#ifndef FUNCTIONAL_HPP
+#define FUNCTIONAL_HPP
+
+#include <functional>
+#include <utility>
+
+/*
+ * Comparator / projection helpers shared by the generic algorithms
+ *
+ * A projection maps an element to the key that is compared, e.g.
+ * quick_sort(first, last, less<>(), &Record::key)
+ */
+namespace P {
+using namespace std;
+
+/*
+ * Default projection (std::identity is C++20)
+ */
+struct identity {
+  template <typename T>
+  constexpr T&& operator()(T&& t) const noexcept {
+    return forward<T>(t);
+  }
+};
+
+/*
+ * Tags for algorithms that have both a stable and an unstable variant
+ */
+struct stable_tag {};
+struct unstable_tag {};
+
+/*
+ * comp(proj(a), proj(b)) as a single binary predicate
+ *
+ * Use when handing the pair to a kernel that only takes a comparator
+ */
+template <typename Compare, typename Proj>
+struct proj_compare {
+  template <typename A, typename B>
+  bool operator()(A&& a, B&& b) const {
+    return invoke(comp, invoke(proj, forward<A>(a)),
+                  invoke(proj, forward<B>(b)));
+  }
+  Compare comp;
+  Proj proj;
+};
+
+template <typename Compare, typename Proj>
+proj_compare<Compare, Proj> make_proj_compare(Compare comp, Proj proj) {
+  return {move(comp), move(proj)};
+}
+
+}  // namespace P
+#endif /* FUNCTIONAL_HPP */
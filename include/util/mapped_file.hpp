@@ -0,0 +1,75 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, munmap, madvise
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <utility>
+
+/*
+ * Read-only memory mapping of a whole file (POSIX), errors reported by
+ * throwing system_error
+ */
+namespace P {
+using namespace std;
+
+class MappedFile {
+ public:
+  MappedFile() = default;
+
+  explicit MappedFile(string const& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw system_error(errno, generic_category(), "open " + path);
+    struct stat st;
+    if (fstat(fd, &st)) {
+      int e = errno;
+      ::close(fd);
+      throw system_error(e, generic_category(), "fstat " + path);
+    }
+    len = st.st_size;
+    if (len > 0) {
+      void* p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+        int e = errno;
+        ::close(fd);
+        throw system_error(e, generic_category(), "mmap " + path);
+      }
+      ptr = static_cast<char const*>(p);
+    }
+    ::close(fd);  // the mapping keeps the file
+  }
+
+  MappedFile(MappedFile&& o) noexcept
+      : ptr(exchange(o.ptr, nullptr)), len(exchange(o.len, 0)) {}
+  MappedFile& operator=(MappedFile&& o) noexcept {
+    swap(ptr, o.ptr);
+    swap(len, o.len);
+    return *this;
+  }
+  MappedFile(MappedFile const&) = delete;
+  MappedFile& operator=(MappedFile const&) = delete;
+  ~MappedFile() {
+    if (ptr) munmap(const_cast<char*>(ptr), len);
+  }
+
+  char const* data() const { return ptr; }
+  size_t size() const { return len; }
+
+  // access pattern hint, e.g. MADV_SEQUENTIAL or MADV_RANDOM
+  void advise(int advice) const {
+    if (ptr) madvise(const_cast<char*>(ptr), len, advice);
+  }
+
+ private:
+  char const* ptr = nullptr;
+  size_t len = 0;
+};
+
+}  // namespace P
+#endif /* MAPPED_FILE_HPP */
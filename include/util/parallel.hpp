@@ -0,0 +1,50 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+/*
+ * Minimal fork-join helpers on std::thread
+ *
+ * nthreads = 0 means one thread per hardware thread
+ */
+namespace P {
+using namespace std;
+
+inline int num_threads(int nthreads = 0) {
+  if (nthreads > 0) return nthreads;
+  return max(1u, thread::hardware_concurrency());
+}
+
+/*
+ * Run f(tid) for tid in [0, nthreads) and join; tid 0 runs on the caller
+ */
+template <typename F>
+void run_threads(int nthreads, F f) {
+  nthreads = num_threads(nthreads);
+  vector<thread> ts;
+  ts.reserve(nthreads - 1);
+  for (int t = 1; t < nthreads; ++t) ts.emplace_back(f, t);
+  f(0);
+  for (auto& t : ts) t.join();
+}
+
+/*
+ * f(i) for i in [lo, hi), split into one contiguous block per thread
+ */
+template <typename I, typename F>
+void parallel_for(I lo, I hi, F f, int nthreads = 0) {
+  if (hi <= lo) return;
+  const long long n = (long long)hi - lo;
+  nthreads = min<long long>(num_threads(nthreads), n);
+  run_threads(nthreads, [&](int t) {
+    I b = lo + I(n * t / nthreads);
+    I e = lo + I(n * (t + 1) / nthreads);
+    for (I i = b; i < e; ++i) f(i);
+  });
+}
+
+}  // namespace P
+#endif /* PARALLEL_HPP */
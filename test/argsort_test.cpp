@@ -0,0 +1,70 @@
+#include <catch2/catch.hpp>
+
+#include "algo/argsort.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <string>
+
+using namespace std;
+using namespace P;
+
+TEST_CASE("argsort", "[argsort]") {
+  mt19937 gen(1);
+  uniform_int_distribution dis(0, 9);
+  int n = GENERATE(0, 1, 2, 33, 1 << 10);
+  vector<int> v;
+  generate_n(back_inserter(v), n, [&dis, &gen]() { return dis(gen); });
+  vector<uint32_t> exp(n);
+  iota(begin(exp), end(exp), 0);
+  stable_sort(begin(exp), end(exp),
+              [&v](uint32_t a, uint32_t b) { return v[a] < v[b]; });
+  DYNAMIC_SECTION(n << " elements") {
+    REQUIRE(argsort(v) == exp);
+    REQUIRE(counting_argsort(begin(v), end(v),
+                             [](int x) { return (unsigned char)x; }) == exp);
+  }
+  DYNAMIC_SECTION(n << " elements, descending from a deque") {
+    deque<int> d(begin(v), end(v));
+    stable_sort(begin(exp), end(exp),
+                [&v](uint32_t a, uint32_t b) { return v[a] > v[b]; });
+    REQUIRE(argsort(begin(d), end(d), greater<>()) == exp);
+  }
+}
+
+TEST_CASE("sort_by_key and apply_permutation", "[argsort]") {
+  mt19937 gen(2);
+  uniform_int_distribution dis(0, 99);
+  int n = GENERATE(0, 1, 5, 4096, 4097, 10000);
+  vector<int> key(n);
+  vector<double> c1(n);
+  vector<string> c2(n);
+  for (int q = 0; q < n; ++q) {
+    key[q] = dis(gen);
+    c1[q] = key[q] * 0.5;
+    c2[q] = to_string(key[q]) + "/" + to_string(q);
+  }
+  auto orig = key;
+  auto perm = sort_by_key(key, c1, c2);
+  REQUIRE(is_sorted(begin(key), end(key)));
+  for (int q = 0; q < n; ++q) {
+    REQUIRE(c1[q] == key[q] * 0.5);
+    REQUIRE(c2[q] == to_string(key[q]) + "/" + to_string(perm[q]));
+  }
+
+  vector<int> gathered(n);
+  gather(perm, begin(orig), begin(gathered));
+  REQUIRE(gathered == key);
+
+  // columns of the same type share one scratch buffer
+  auto a = orig, b = orig;
+  vector<double> c(n);
+  for (int q = 0; q < n; ++q) b[q] = -q, c[q] = q * 0.25;
+  apply_permutation(perm, a, b, c);
+  REQUIRE(a == key);
+  for (int q = 0; q < n; ++q) {
+    REQUIRE(b[q] == -(int)perm[q]);
+    REQUIRE(c[q] == perm[q] * 0.25);
+  }
+}
@@ -0,0 +1,52 @@
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <vector>
+
+#include "ds/binary_lifting.hpp"
+
+using namespace P;
+using namespace std;
+
+TEST_CASE("binary lifting", "[graph]") {
+  // a path into the cycle 5 -> 6 -> 7 -> 5
+  vector<int> f{1, 2, 3, 4, 5, 6, 7, 5};
+  BinaryLifting b(f, 10);
+  REQUIRE(b.N() == 8);
+  REQUIRE(b.levels() == 4);
+  REQUIRE(b.up(0, 0) == 1);
+  REQUIRE(b.up(1, 0) == 2);
+  REQUIRE(b.up(3, 0) == 5);  // 8 steps
+  REQUIRE(b.jump(0, 0) == 0);
+  REQUIRE(b.jump(0, 4) == 4);
+  REQUIRE(b.jump(0, 6) == 6);
+  REQUIRE(b.jump(0, 9) == 6);
+  REQUIRE(b.jump(0, 10) == 7);
+  REQUIRE(b.jump(0, 20) == 5);  // beyond max_k
+
+  // a tree: jumps beyond max_k stop at the root
+  vector<int> parent{0, 0, 1, 2, 3};
+  BinaryLifting t(parent, 2);
+  REQUIRE(t.jump(4, 3) == 1);
+  REQUIRE(t.jump(4, 1'000'000'000'000LL) == 0);
+
+  REQUIRE(BinaryLifting(f, 0).levels() == 1);
+  REQUIRE(BinaryLifting(f, 1).levels() == 1);
+  REQUIRE(BinaryLifting(f, 2).levels() == 2);
+  REQUIRE(BinaryLifting({}, 5).N() == 0);
+}
+
+TEST_CASE("binary lifting random", "[graph]") {
+  const int n = GENERATE(1, 100, 70'000);
+  mt19937 gen(n);
+  uniform_int_distribution<> dis(0, n - 1);
+  vector<int> f(n);
+  for (auto& x : f) x = dis(gen);
+  auto nthreads = GENERATE(1, 3);
+  BinaryLifting b(f, 1 << 12, nthreads);
+  for (int q = 0; q < 200; ++q) {
+    int v = dis(gen), k = gen() % 5000, x = v;
+    for (int i = 0; i < k; ++i) x = f[x];
+    REQUIRE(b.jump(v, k) == x);
+  }
+}
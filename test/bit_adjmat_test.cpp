@@ -0,0 +1,76 @@
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <vector>
+
+#include "ds/bit_adjmat.hpp"
+#include "ds/graph.hpp"
+
+using namespace P;
+using namespace std;
+
+TEST_CASE("bit adjacency matrix", "[graph]") {
+  BitAdjMat m(70);
+  m.set(3, 69);
+  m.set(3, 1);
+  m.set(69, 0);
+  REQUIRE(m.test(3, 69));
+  REQUIRE(m[{3, 1}]);
+  REQUIRE_FALSE(m.test(69, 3));
+  REQUIRE(m.degree(3) == 2);
+  m.set(3, 1, false);
+  REQUIRE(m.degree(3) == 1);
+  REQUIRE(m.words() == 2);
+
+  auto t = m.transpose();
+  REQUIRE(t.test(69, 3));
+  REQUIRE(t.test(0, 69));
+  REQUIRE(t.degree(69) == 1);
+  REQUIRE(t.transpose() == m);
+}
+
+TEST_CASE("bit adjacency matrix operations", "[graph]") {
+  const int n = GENERATE(1, 2, 63, 64, 65, 200);
+  mt19937 gen(n);
+  uniform_int_distribution<> dis(0, n - 1);
+  AdjList al(n), und(n);
+  for (int q = 0; q < 2 * n; ++q) {
+    int u = dis(gen), v = dis(gen);
+    al[u].push_back(v);
+    if (u != v && find(und[u].begin(), und[u].end(), Node(v)) == und[u].end()) {
+      und[u].push_back(v);
+      und[v].push_back(u);
+    }
+  }
+  auto m = al.to_bit_adjmat();
+  auto mat = al.to_adjmat();
+  CAPTURE(n);
+  for (int u = 0; u < n; ++u)
+    for (int v = 0; v < n; ++v) {
+      REQUIRE(m.test(u, v) == (mat[{u, v}] > 0));
+      REQUIRE(m.transpose().test(v, u) == m.test(u, v));
+    }
+
+  // closure: v reachable from u in >= 1 step
+  auto tc = m.transitive_closure();
+  for (int u = 0; u < n; ++u) {
+    vector<bool> reach(n);
+    for (auto v : al[u])
+      al.bfs(v, [&reach](Node x) { reach[x] = true; });
+    for (int v = 0; v < n; ++v) REQUIRE(tc.test(u, v) == reach[v]);
+  }
+
+  auto um = und.to_bit_adjmat();
+  long long tri = 0;
+  for (int u = 0; u < n; ++u)
+    for (int v = u + 1; v < n; ++v)
+      for (int w = v + 1; w < n; ++w)
+        tri += um.test(u, v) && um.test(v, w) && um.test(u, w);
+  REQUIRE(um.triangles() == tri);
+  for (int u = 0; u < n; ++u) {
+    REQUIRE(um.degree(u) == (int)und[u].size());
+    int v = dis(gen), c = 0;
+    for (int w = 0; w < n; ++w) c += um.test(u, w) && um.test(v, w);
+    REQUIRE(um.common_neighbors(u, v) == c);
+  }
+}
@@ -0,0 +1,67 @@
+#include <catch2/catch.hpp>
+
+#include "ds/concurrent_dsuf.hpp"
+#include "ds/dsuf.hpp"
+#include "util/parallel.hpp"
+
+#include <atomic>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace P;
+
+TEST_CASE("concurrent dsuf sequential use", "[concurrent_dsuf]") {
+  ConcurrentDSUF d(6);
+  REQUIRE(d.uni(0, 1));
+  REQUIRE(d.uni(2, 3));
+  REQUIRE_FALSE(d.uni(1, 0));
+  REQUIRE(d.same_set(0, 1));
+  REQUIRE_FALSE(d.same_set(1, 2));
+  REQUIRE(d.uni(1, 3));
+  REQUIRE(d.same_set(0, 2));
+  REQUIRE(d.root(0) == d.root(3));
+  REQUIRE_FALSE(d.same_set(4, 5));
+}
+
+/*
+ * Linearizability checks:
+ * - a thread always sees its own completed unions (same_set right after uni)
+ * - exactly n - (#sets) unions report success
+ * - the final partition equals the sequential DSUF over the same edges
+ */
+TEST_CASE("concurrent dsuf stress", "[concurrent_dsuf]") {
+  const int n = GENERATE(16, 1000, 1 << 15);
+  const int nthreads = 4, m = 2 * n;
+  ConcurrentDSUF d(n);
+  vector<vector<pair<int, int>>> edges(nthreads);
+  for (int t = 0; t < nthreads; ++t) {
+    mt19937 gen(t);
+    uniform_int_distribution<> dis(0, n - 1);
+    for (int q = 0; q < m / nthreads; ++q)
+      edges[t].push_back({dis(gen), dis(gen)});
+  }
+  atomic<int> merged{0}, violations{0};
+  run_threads(nthreads, [&](int t) {
+    mt19937 gen(100 + t);
+    uniform_int_distribution<> dis(0, n - 1);
+    for (auto [u, v] : edges[t]) {
+      merged += d.uni(u, v);
+      if (!d.same_set(u, v)) ++violations;
+      d.same_set(dis(gen), dis(gen));  // concurrent read-only traffic
+    }
+  });
+  REQUIRE(violations == 0);
+
+  DSUF s(n);
+  for (auto const& es : edges)
+    for (auto [u, v] : es) s.uni(u, v);
+  int sets = 0, csets = 0;
+  for (int u = 0; u < n; ++u) {
+    sets += s.root(u) == u;
+    csets += d.root(u) == u;
+    REQUIRE(d.same_set(u, s.root(u)));
+  }
+  REQUIRE(sets == csets);
+  REQUIRE(merged == n - sets);
+}
@@ -0,0 +1,172 @@
+#include <catch2/catch.hpp>
+
+#include "ds/contraction_hierarchy.hpp"
+
+#include <climits>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+using namespace std;
+using namespace P;
+namespace fs = std::filesystem;
+
+namespace {
+// length of path in g, INF if an edge is missing
+int path_length(WeightedAdjList const& g, vector<int> const& path) {
+  int len = 0;
+  for (int q = 0; q + 1 < (int)path.size(); ++q) {
+    int w = INF;
+    for (auto e : g[path[q]])
+      if (e.val == path[q + 1]) w = min(w, e.w);
+    if (w == INF) return INF;
+    len += w;
+  }
+  return len;
+}
+
+void check_queries(WeightedAdjList const& g, ContractionHierarchy const& ch) {
+  BidirectionalWorkspace ws;
+  for (int s = 0; s < g.N(); s += max(1, g.N() / 30)) {
+    auto exp = g.dijkstra(s);
+    for (int t = 0; t < g.N(); ++t) {
+      CAPTURE(s, t);
+      REQUIRE(ch.query(ws, s, t) == exp[t]);
+      auto path = ch.path(ws);
+      if (exp[t] == INF) {
+        REQUIRE(path.empty());
+        continue;
+      }
+      REQUIRE(path.front() == s);
+      REQUIRE(path.back() == t);
+      REQUIRE(path_length(g, path) == exp[t]);
+    }
+  }
+}
+}  // namespace
+
+TEST_CASE("contraction hierarchy", "[graph][ch]") {
+  const int n = GENERATE(1, 2, 30, 400);
+  const bool directed = GENERATE(false, true);
+  const int nthreads = GENERATE(1, 4);
+  mt19937 gen(n + directed);
+  uniform_int_distribution<> dis(0, n - 1), wdis(0, 20);
+  WeightedAdjList g(n);
+  for (int q = 0; q < 2 * n; ++q) {
+    int u = dis(gen), v = dis(gen), w = wdis(gen);
+    g[u].push_back({v, w});
+    if (!directed) g[v].push_back({u, w});
+  }
+  CAPTURE(n, directed, nthreads);
+  ContractionHierarchy ch(g, nthreads);
+  REQUIRE(ch.N() == n);
+  vector<int> ranks;
+  for (int v = 0; v < n; ++v) ranks.push_back(ch.rank_of(v));
+  sort(ranks.begin(), ranks.end());
+  for (int v = 0; v < n; ++v) REQUIRE(ranks[v] == v);  // a permutation
+  check_queries(g, ch);
+}
+
+TEST_CASE("contraction hierarchy on a grid", "[graph][ch]") {
+  const int side = 25;
+  WeightedAdjList g(side * side);
+  mt19937 gen(side);
+  uniform_int_distribution<> wdis(1, 9);
+  for (int u = 0; u < side * side; ++u) {
+    if (u % side + 1 < side) g[u].push_back({u + 1, wdis(gen)});
+    if (u + side < side * side) g[u].push_back({u + side, wdis(gen)});
+    if (u % side > 0) g[u].push_back({u - 1, wdis(gen)});
+    if (u >= side) g[u].push_back({u - side, wdis(gen)});
+  }
+  check_queries(g, ContractionHierarchy(g));
+}
+
+TEST_CASE("contraction hierarchy serialization", "[graph][ch]") {
+  const int n = 200;
+  mt19937 gen(n);
+  uniform_int_distribution<> dis(0, n - 1), wdis(1, 100);
+  WeightedAdjList g(n);
+  for (int q = 0; q < 3 * n; ++q) g[dis(gen)].push_back({dis(gen), wdis(gen)});
+  ContractionHierarchy ch(g);
+
+  auto p = fs::temp_directory_path() / "pdsalgo_ch_test.bin";
+  ch.save(p.string());
+  auto loaded = ContractionHierarchy::load(p.string());
+  REQUIRE(loaded.N() == n);
+  REQUIRE(loaded.arcs() == ch.arcs());
+  check_queries(g, loaded);
+
+  // after magic, |V|, rank: up_off at 28 + 4n, up arcs at 40 + 8n
+  auto patch = [&](long pos, int x) {
+    ch.save(p.string());
+    auto f = open_file(p.string(), "r+b");
+    fseek(f.get(), pos, SEEK_SET);
+    write_values(f.get(), &x, 1);
+  };
+  patch(28 + 4 * n + 4, INT_MAX);  // up_off[1]: past the arcs
+  REQUIRE_THROWS_AS(ContractionHierarchy::load(p.string()), invalid_argument);
+  patch(28 + 4 * n + 4 * n, 0);  // up_off[n]: not the number of arcs
+  REQUIRE_THROWS_AS(ContractionHierarchy::load(p.string()), invalid_argument);
+  patch(40 + 8 * n, n);  // target of the first up arc
+  REQUIRE_THROWS_AS(ContractionHierarchy::load(p.string()), invalid_argument);
+  patch(40 + 8 * n + 8, n);  // mid of the first up arc
+  REQUIRE_THROWS_AS(ContractionHierarchy::load(p.string()), invalid_argument);
+
+  // the arrays as load reads them, to corrupt shortcuts consistently
+  ch.save(p.string());
+  vector<int> rank, up_off, down_off;
+  vector<ContractionHierarchy::Arc> up, down;
+  {
+    auto f = open_file(p.string(), "rb");
+    char magic[8];
+    int fn;
+    read_values(f.get(), magic, 8);
+    read_values(f.get(), &fn, 1);
+    rank = read_vector<int>(f.get());
+    up_off = read_vector<int>(f.get());
+    up = read_vector<ContractionHierarchy::Arc>(f.get());
+    down_off = read_vector<int>(f.get());
+    down = read_vector<ContractionHierarchy::Arc>(f.get());
+  }
+  auto has_arc = [&](int u, int v) {
+    bool upward = rank[u] < rank[v];
+    auto const& off = upward ? up_off : down_off;
+    auto const& arcs = upward ? up : down;
+    int at = upward ? u : v, to = upward ? v : u;
+    for (int q = off[at]; q < off[at + 1]; ++q)
+      if (arcs[q].v == to) return true;
+    return false;
+  };
+  auto mid_pos = [n](int q) { return 40 + 8 * n + 12 * q + 8; };
+
+  patch(20, rank[1]);  // rank not a permutation
+  REQUIRE_THROWS_AS(ContractionHierarchy::load(p.string()), invalid_argument);
+  int shortcut = -1, missing = -1, missing_mid = -1;
+  for (int x = 0; x < n; ++x)
+    for (int q = up_off[x]; q < up_off[x + 1]; ++q) {
+      if (up[q].mid != -1) {
+        shortcut = q;
+        patch(mid_pos(q), x);  // mid is an endpoint: unpack would not end
+        REQUIRE_THROWS_AS(ContractionHierarchy::load(p.string()),
+                          invalid_argument);
+        continue;
+      }
+      for (int m = 0; m < n && missing == -1; ++m)
+        if (rank[m] < rank[x] && !has_arc(x, m))
+          missing = q, missing_mid = m;
+    }
+  REQUIRE(shortcut != -1);
+  REQUIRE(missing != -1);
+  patch(mid_pos(missing), missing_mid);  // bypassed arc x -> mid missing
+  REQUIRE_THROWS_AS(ContractionHierarchy::load(p.string()), invalid_argument);
+
+  {
+    auto f = open_file(p.string(), "wb");
+    fputs("not a hierarchy", f.get());
+  }
+  REQUIRE_THROWS_AS(ContractionHierarchy::load(p.string()), invalid_argument);
+  fs::resize_file(p, 4);
+  REQUIRE_THROWS_AS(ContractionHierarchy::load(p.string()), system_error);
+  fs::remove(p);
+  REQUIRE_THROWS_AS(ContractionHierarchy::load(p.string()), system_error);
+}
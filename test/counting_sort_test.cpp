@@ -1,6 +1,7 @@
 #include <catch2/catch.hpp>
 
 #include <algorithm>
+#include <deque>
 #include <iostream>
 #include "algo/counting_sort.hpp"
 
@@ -52,3 +53,18 @@ TEST_CASE("counting sort", "[counting_sort]") {
     }
   }
 }
+
+TEST_CASE("counting sort generic", "[counting_sort]") {
+  deque<pair<unsigned char, int>> d;
+  for (int q = 0; q < 100; ++q) d.push_back({(q * 37) % 11, q});
+  vector<pair<unsigned char, int>> res(d.size());
+  counting_sort(begin(d), end(d), begin(res), &pair<unsigned char, int>::first);
+  auto exp = vector(begin(d), end(d));
+  stable_sort(begin(exp), end(exp),
+              [](auto a, auto b) { return a.first < b.first; });
+  REQUIRE(res == exp);
+
+  string s = "hellozzaz";
+  counting_sort_inplace(begin(s), end(s));
+  REQUIRE(s == "aehllozzz");
+}
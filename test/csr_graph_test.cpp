@@ -0,0 +1,88 @@
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "ds/csr_graph.hpp"
+
+using namespace P;
+using namespace std;
+
+TEST_CASE("csr graph construction", "[graph][csr]") {
+  vector<pair<int, Node>> edges{{2, 0}, {0, 1}, {2, 1}, {0, 3}, {2, 3}};
+  CsrGraph g(4, edges);
+  REQUIRE(g.N() == 4);
+  REQUIRE(g.M() == 5);
+  REQUIRE(g.offsets() == vector<int>{0, 2, 2, 5, 5});
+  vector<Node> exp{1, 3, 0, 1, 3};  // per source, in edge list order
+  REQUIRE(g.targets() == exp);
+  REQUIRE(g[1].empty());
+  REQUIRE(g[2].size() == 3);
+  REQUIRE(g[2][1] == Node(1));
+
+  CsrGraph<> empty;
+  REQUIRE(empty.N() == 0);
+  REQUIRE(empty.M() == 0);
+}
+
+TEST_CASE("csr graph matches adjacency list", "[graph][csr]") {
+  auto n = GENERATE(1, 2, 17, 100, 1000);
+  auto deg = GENERATE(0, 1, 3);
+  mt19937 gen(n * 10 + deg);
+  uniform_int_distribution<> dis(0, n - 1), wdis(0, 100);
+
+  WeightedAdjList al(n), dag(n);
+  vector<pair<int, WeightedNode>> edges;
+  for (int q = 0; q < n * deg; ++q) {
+    int u = dis(gen), v = dis(gen), w = wdis(gen);
+    al[u].push_back({v, w});
+    edges.push_back({u, {v, w}});
+    if (u != v) dag[min(u, v)].push_back({max(u, v), w});
+  }
+  WeightedCsrGraph g(al), ge(n, edges), gdag(dag);
+  CAPTURE(n, deg);
+
+  REQUIRE(g.M() == n * deg);
+  REQUIRE(g.offsets() == ge.offsets());
+  REQUIRE(g.targets() == ge.targets());
+  REQUIRE(g.weights() == ge.weights());
+  for (int u = 0; u < n; ++u)
+    REQUIRE(vector<WeightedNode>(g[u].begin(), g[u].end()) == al[u]);
+
+  auto root = dis(gen);
+  auto collect = [](auto const& graph, auto traverse) {
+    vector<int> seq;
+    traverse(graph, [&seq](Node x) { seq.push_back(x); });
+    return seq;
+  };
+  auto dfs = [root](auto const& gr, auto f) { gr.dfs(root, f); };
+  auto bfs = [root](auto const& gr, auto f) { gr.bfs(root, f); };
+  auto topo = [](auto const& gr, auto f) { gr.topological_sort(f); };
+  REQUIRE(collect(g, dfs) == collect(al, dfs));
+  REQUIRE(collect(g, bfs) == collect(al, bfs));
+  REQUIRE(collect(gdag, topo) == collect(dag, topo));
+
+  vector<pair<int, int>> d1, d2;
+  g.bfs_depth(root, [&d1](Node x, int d) { d1.push_back({x, d}); });
+  al.bfs_depth(root, [&d2](Node x, int d) { d2.push_back({x, d}); });
+  REQUIRE(d1 == d2);
+
+  REQUIRE(g.is_cyclic() == al.is_cyclic());
+  REQUIRE(g.strongly_connected_components() ==
+          al.strongly_connected_components());
+  REQUIRE(g.parallel_scc(2) == al.parallel_scc(2));
+  REQUIRE_FALSE(gdag.is_cyclic());
+  REQUIRE(g.dijkstra(root) == al.dijkstra(root));
+}
+
+TEST_CASE("csr graph transpose", "[graph][csr]") {
+  vector<pair<int, WeightedNode>> edges{
+      {0, {1, 5}}, {2, {1, 7}}, {1, {0, 3}}};
+  WeightedCsrGraph g(3, edges);
+  auto r = g.transpose();
+  REQUIRE(r.M() == 3);
+  REQUIRE(r.offsets() == vector<int>{0, 1, 3, 3});
+  REQUIRE(r.targets() == vector<int>{1, 0, 2});
+  REQUIRE(r.weights() == vector<int>{3, 5, 7});
+}
@@ -0,0 +1,44 @@
+#include <catch2/catch.hpp>
+
+#include "ds/dary_heap.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace P;
+
+TEMPLATE_TEST_CASE_SIG("indexed d-ary heap", "[dary_heap]", ((int D), D), 2,
+                       4, 8) {
+  const int n = GENERATE(1, 5, 300);
+  mt19937 gen(n);
+  uniform_int_distribution<> dis(0, 1000);
+  IndexedDaryHeap<D> h(n);
+  vector<int> key(n, -1);  // reference, -1 if absent
+  for (int q = 0; q < 20 * n; ++q) {
+    int v = gen() % n;
+    if (gen() % 3 == 0 && !h.empty()) {
+      auto [k, u] = h.pop();
+      int best = *min_element(key.begin(), key.end(), [](int a, int b) {
+        return (unsigned)a < (unsigned)b;  // -1 is largest
+      });
+      REQUIRE(k == best);
+      REQUIRE(key[u] == k);
+      key[u] = -1;
+    } else if (key[v] == -1) {
+      key[v] = dis(gen);
+      h.push(v, key[v]);
+    } else {
+      key[v] -= min(key[v], dis(gen) % 10);  // decrease
+      h.push(v, key[v]);
+    }
+    REQUIRE(h.size() == n - count(key.begin(), key.end(), -1));
+    REQUIRE(h.contains(v) == (key[v] != -1));
+    if (h.contains(v)) REQUIRE(h.key(v) == key[v]);
+  }
+
+  h.clear(n);
+  REQUIRE(h.empty());
+  for (int v = 0; v < n; ++v) REQUIRE_FALSE(h.contains(v));
+}
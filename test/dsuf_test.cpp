@@ -0,0 +1,55 @@
+#include <catch2/catch.hpp>
+
+#include "ds/dsuf.hpp"
+
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace P;
+
+TEMPLATE_TEST_CASE("dsuf", "[dsuf]", DSUF, BasicDSUF<dsuf_index<int64_t>>,
+                   (BasicDSUF<dsuf_by_rank, dsuf_index<uint32_t>>),
+                   BasicDSUF<dsuf_by_rank>) {
+  const int n = GENERATE(1, 2, 17, 1000);
+  TestType d(n);
+  REQUIRE(d.N() == (typename TestType::Index)n);
+  // reference: naive labels
+  vector<int> label(n);
+  iota(begin(label), end(label), 0);
+  mt19937 gen(n);
+  uniform_int_distribution<> dis(0, n - 1);
+  for (int q = 0; q < n; ++q) {
+    int u = dis(gen), v = dis(gen);
+    d.uni(u, v);
+    int lu = label[u], lv = label[v];
+    for (auto& l : label)
+      if (l == lv) l = lu;
+    int a = dis(gen), b = dis(gen);
+    REQUIRE(d.same_set(a, b) == (label[a] == label[b]));
+  }
+  for (int u = 0; u < n; ++u) REQUIRE(d.same_set(u, d.root(u)));
+}
+
+TEST_CASE("dsuf sizes and growing universe", "[dsuf]") {
+  DSUF d;
+  d.reserve(4);
+  for (int q = 0; q < 4; ++q) REQUIRE(d.add_element() == q);
+  d.uni(0, 1);
+  d.uni(2, 1);
+  REQUIRE(d.size(0) == 3);
+  REQUIRE(d.size(3) == 1);
+  int e = d.add_element();
+  d.uni(e, 3);
+  REQUIRE(d.size(e) == 2);
+  REQUIRE_FALSE(d.same_set(e, 0));
+}
+
+TEST_CASE("dsuf large n", "[dsuf]") {
+  const int n = 1 << 20;
+  BasicDSUF<dsuf_by_rank, dsuf_index<uint32_t>> d(n);
+  for (int q = 0; q + 1 < n; ++q) d.uni(q + 1, q);
+  REQUIRE(d.same_set(0, n - 1));
+}
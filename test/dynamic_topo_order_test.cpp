@@ -0,0 +1,60 @@
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "ds/dynamic_topo_order.hpp"
+#include "ds/graph.hpp"
+
+using namespace P;
+using namespace std;
+
+TEST_CASE("dynamic topological order", "[graph]") {
+  DynamicTopoOrder t(4);
+  REQUIRE(t.order() == vector<int>{0, 1, 2, 3});
+  REQUIRE(t.add_edge(0, 2));
+  REQUIRE(t.order() == vector<int>{0, 1, 2, 3});
+  REQUIRE(t.add_edge(3, 1));
+  REQUIRE(t.precedes(3, 1));
+  REQUIRE(t.order() == vector<int>{0, 3, 2, 1});
+  REQUIRE(t.add_edge(2, 3));
+  REQUIRE(t.order() == vector<int>{0, 2, 3, 1});
+  REQUIRE_FALSE(t.add_edge(1, 0));
+  REQUIRE_FALSE(t.add_edge(1, 2));
+  REQUIRE_FALSE(t.add_edge(3, 3));
+  REQUIRE(t.order() == vector<int>{0, 2, 3, 1});
+  for (int v = 0; v < 4; ++v) REQUIRE(t.order()[t.position(v)] == v);
+}
+
+TEST_CASE("dynamic topological order random insertions", "[graph]") {
+  const int n = GENERATE(2, 10, 200);
+  const int m = GENERATE(1, 3);
+  mt19937 gen(n * m);
+  uniform_int_distribution<> dis(0, n - 1);
+
+  AdjList al(n);
+  for (int q = 0; q < m * n / 2; ++q) {
+    int a = dis(gen), b = dis(gen);
+    if (a < b) al[a].push_back(b);
+  }
+  DynamicTopoOrder t(al);
+  auto valid = [&] {
+    vector<Node> seq(t.order().begin(), t.order().end());
+    return al.is_topological_sort(seq);
+  };
+  REQUIRE(valid());
+
+  for (int q = 0; q < m * n; ++q) {
+    int u = dis(gen), v = dis(gen);
+    al[u].push_back(v);
+    bool cyclic = al.is_cyclic();
+    CAPTURE(n, m, q, u, v);
+    REQUIRE(t.add_edge(u, v) == !cyclic);
+    if (cyclic) al[u].pop_back();
+    REQUIRE(valid());
+  }
+
+  al[0].push_back(0);
+  REQUIRE_THROWS_AS(DynamicTopoOrder(al), invalid_argument);
+}
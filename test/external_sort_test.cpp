@@ -0,0 +1,93 @@
+#include <catch2/catch.hpp>
+
+#include "algo/external_sort.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+using namespace std;
+using namespace P;
+namespace fs = std::filesystem;
+
+namespace {
+struct Rec {
+  uint64_t key;
+  uint32_t payload;
+  bool operator<(Rec const& r) const { return key < r.key; }
+};
+
+template <typename E>
+void write_recs(fs::path const& p, vector<E> const& v) {
+  auto f = open_file(p.string(), "wb");
+  fwrite(v.data(), sizeof(E), v.size(), f.get());
+}
+
+template <typename E>
+vector<E> read_recs(fs::path const& p) {
+  vector<E> v(fs::file_size(p) / sizeof(E));
+  auto f = open_file(p.string(), "rb");
+  REQUIRE(fread(v.data(), sizeof(E), v.size(), f.get()) == v.size());
+  return v;
+}
+}  // namespace
+
+TEST_CASE("external sort", "[external_sort]") {
+  auto dir = fs::temp_directory_path();
+  auto in = dir / "pdsalgo_external_sort_in.bin";
+  auto out = dir / "pdsalgo_external_sort_out.bin";
+
+  mt19937_64 gen(42);
+  int n = GENERATE(0, 1, 100, 5000);
+  vector<Rec> v(n);
+  for (int q = 0; q < n; ++q) v[q] = {gen() % 1000, (uint32_t)q};
+  write_recs(in, v);
+
+  ExternalSortConfig cfg;
+  cfg.temp_dir = dir.string();
+  cfg.memory_budget = GENERATE(1 << 10, 1 << 20);  // multi-pass / 1 pass
+  cfg.block_size = 64;
+  DYNAMIC_SECTION(n << " records, budget " << cfg.memory_budget) {
+    external_sort<Rec>(in.string(), out.string(), cfg);
+    auto res = read_recs<Rec>(out);
+    REQUIRE(res.size() == v.size());
+    REQUIRE(is_sorted(begin(res), end(res)));
+    vector<uint32_t> seen;
+    for (auto r : res) seen.push_back(r.payload);
+    sort(begin(seen), end(seen));
+    for (int q = 0; q < n; ++q) REQUIRE(seen[q] == (uint32_t)q);
+  }
+  DYNAMIC_SECTION(n << " records, budget " << cfg.memory_budget
+                    << ", unique, descending") {
+    cfg.unique = true;
+    external_sort<Rec>(in.string(), out.string(), cfg,
+                       [](Rec a, Rec b) { return a.key > b.key; });
+    auto res = read_recs<Rec>(out);
+    vector<uint64_t> exp;
+    for (auto r : v) exp.push_back(r.key);
+    sort(begin(exp), end(exp), greater<>());
+    exp.erase(unique(begin(exp), end(exp)), end(exp));
+    REQUIRE(res.size() == exp.size());
+    for (size_t q = 0; q < exp.size(); ++q) REQUIRE(res[q].key == exp[q]);
+  }
+  fs::remove(in);
+  fs::remove(out);
+}
+
+TEST_CASE("external sort in place and bad input", "[external_sort]") {
+  auto p = fs::temp_directory_path() / "pdsalgo_external_sort_inplace.bin";
+  vector<uint32_t> v{5, 3, 9, 1, 1, 7};
+  write_recs(p, v);
+  external_sort<uint32_t>(p.string(), p.string());
+  sort(begin(v), end(v));
+  REQUIRE(read_recs<uint32_t>(p) == v);
+
+  vector<char> odd{1, 2, 3};
+  write_recs(p, odd);
+  REQUIRE_THROWS_AS(external_sort<uint32_t>(p.string(), p.string()),
+                    invalid_argument);
+  REQUIRE_THROWS_AS(external_sort<uint32_t>("/nonexistent/in", p.string()),
+                    system_error);
+  fs::remove(p);
+}
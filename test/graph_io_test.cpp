@@ -0,0 +1,162 @@
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ds/graph_io.hpp"
+
+using namespace P;
+using namespace std;
+namespace fs = std::filesystem;
+
+fs::path write_text(string const& name, string const& s) {
+  auto p = fs::temp_directory_path() / name;
+  ofstream(p, ios::binary) << s;
+  return p;
+}
+
+template <typename G, typename H>
+bool same_graph(G const& a, H const& b) {
+  if (a.N() != b.N()) return false;
+  for (int u = 0; u < a.N(); ++u) {
+    auto const& x = a[u];
+    auto const& y = b[u];
+    if (x.size() != y.size() || !equal(x.begin(), x.end(), y.begin()))
+      return false;
+  }
+  return true;
+}
+
+TEST_CASE("load edge list", "[graph]") {
+  auto p = write_text("pdsalgo_edges.txt",
+                      "# comment\n0 1\r\n\n  2 0\n% other comment\n2\t5\n0 1");
+  auto al = load_edge_list(p);
+  AdjList exp(6);
+  exp[0] = {1, 1};
+  exp[2] = {0, 5};
+  REQUIRE(same_graph(al, exp));
+
+  write_text("pdsalgo_edges.txt", "0 1 7\n1 0 -3\n");
+  auto wl = load_edge_list<WeightedNode>(p);
+  REQUIRE(wl.N() == 2);
+  REQUIRE(wl[0] == vector<WeightedNode>{{1, 7}});
+  REQUIRE(wl[1] == vector<WeightedNode>{{0, -3}});
+
+  for (auto bad : {"0 1\n2\n", "0 x\n", "0 -1\n", "99999999999 0\n",
+                   "0 1x\n", "0 1 2\n", "0 2147483647\n"}) {
+    write_text("pdsalgo_edges.txt", bad);
+    CAPTURE(bad);
+    REQUIRE_THROWS_AS(load_edge_list(p), invalid_argument);
+  }
+  write_text("pdsalgo_edges.txt", "0 1\n");
+  REQUIRE_THROWS_AS(load_edge_list<WeightedNode>(p), invalid_argument);
+  write_text("pdsalgo_edges.txt", "0 1 7 junk\n");
+  REQUIRE_THROWS_AS(load_edge_list<WeightedNode>(p), invalid_argument);
+  write_text("pdsalgo_edges.txt", "0 1 7 \t\n");
+  REQUIRE(load_edge_list<WeightedNode>(p).N() == 2);
+  write_text("pdsalgo_edges.txt", "");
+  REQUIRE(load_edge_list(p).N() == 0);
+  fs::remove(p);
+  REQUIRE_THROWS_AS(load_edge_list(p), system_error);
+}
+
+TEST_CASE("load adjacency", "[graph]") {
+  auto p = write_text("pdsalgo_adj.txt", "0: 1, 2\n1:\n2: 0 , 2 \n5:\n");
+  auto al = load_adjacency(p);
+  AdjList exp(6);
+  exp[0] = {1, 2};
+  exp[2] = {0, 2};
+  REQUIRE(same_graph(al, exp));
+
+  for (auto bad : {"0 1\n", "0: 1, x\n", ": 1\n", "2147483647:\n",
+                   "0: 1, 2147483647\n"}) {
+    write_text("pdsalgo_adj.txt", bad);
+    CAPTURE(bad);
+    REQUIRE_THROWS_AS(load_adjacency(p), invalid_argument);
+  }
+  fs::remove(p);
+}
+
+TEST_CASE("load large text graphs in parallel", "[graph]") {
+  const int n = 100'000, m = 400'000;  // several MB: one chunk per thread
+  mt19937 gen;
+  uniform_int_distribution<> dis(0, n - 1);
+  WeightedAdjList exp(n);
+  string edges, adj;
+  for (int q = 0; q < m; ++q) {
+    int u = q ? dis(gen) : n - 1, v = dis(gen), w = dis(gen);
+    exp[u].push_back({v, w});
+    edges += to_string(u) + ' ' + to_string(v) + ' ' + to_string(w) + '\n';
+  }
+  AdjList unweighted(n);
+  for (int u = 0; u < n; ++u) {
+    adj += to_string(u) + ":";
+    for (auto [v, w] : exp[u]) {
+      adj += ' ' + to_string(v) + ',';
+      unweighted[u].push_back(v);
+    }
+    adj += '\n';
+  }
+
+  auto pe = write_text("pdsalgo_large_edges.txt", edges);
+  auto pa = write_text("pdsalgo_large_adj.txt", adj);
+  for (int nthreads : {1, 3}) {
+    CAPTURE(nthreads);
+    REQUIRE(same_graph(load_edge_list<WeightedNode>(pe, nthreads), exp));
+    REQUIRE(same_graph(load_adjacency(pa, nthreads), unweighted));
+  }
+  fs::remove(pe);
+  fs::remove(pa);
+}
+
+TEST_CASE("binary csr graph", "[graph]") {
+  const int n = 1000;
+  mt19937 gen;
+  uniform_int_distribution<> dis(0, n - 1), wdis(0, 100);
+  WeightedAdjList al(n);
+  AdjList ul(n);
+  for (int q = 0; q < 5 * n; ++q) {
+    int u = dis(gen), v = dis(gen);
+    al[u].push_back({v, wdis(gen)});
+    ul[u].push_back(v);
+  }
+  auto p = fs::temp_directory_path() / "pdsalgo_graph.bin";
+
+  save_csr_graph(WeightedCsrGraph(al), p);
+  MappedCsrGraph<WeightedNode> g(p);
+  REQUIRE(g.N() == n);
+  REQUIRE(g.M() == 5 * n);
+  REQUIRE(same_graph(g, al));
+  REQUIRE(g.dijkstra(0) == al.dijkstra(0));
+  REQUIRE_THROWS_AS(MappedCsrGraph<>(p), invalid_argument);
+
+  save_csr_graph(CsrGraph<>(ul), p);
+  MappedCsrGraph<> h(p);
+  REQUIRE(same_graph(h, ul));
+  REQUIRE(h.strongly_connected_components() ==
+          ul.strongly_connected_components());
+
+  auto patch = [&](size_t i, int x) {  // overwrite the i-th int after the header
+    fstream f(p, ios::binary | ios::in | ios::out);
+    f.seekp(sizeof(CsrFileHeader) + i * sizeof(int));
+    f.write(reinterpret_cast<char const*>(&x), sizeof(x));
+  };
+  patch(1, 5 * n);  // offsets not monotone
+  REQUIRE_THROWS_AS(MappedCsrGraph<>(p), invalid_argument);
+  REQUIRE(MappedCsrGraph<>(p, false).N() == n);  // trusted: not checked
+  save_csr_graph(CsrGraph<>(ul), p);
+  patch(n + 1, n);  // target out of range
+  REQUIRE_THROWS_AS(MappedCsrGraph<>(p), invalid_argument);
+  patch(n + 1, -1);
+  REQUIRE_THROWS_AS(MappedCsrGraph<>(p), invalid_argument);
+
+  fs::resize_file(p, fs::file_size(p) - 4);
+  REQUIRE_THROWS_AS(MappedCsrGraph<>(p), invalid_argument);
+  auto bad = write_text("pdsalgo_graph.bin", "not a graph file at all, really");
+  REQUIRE_THROWS_AS(MappedCsrGraph<>(bad), invalid_argument);
+  fs::remove(p);
+}
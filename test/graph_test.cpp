@@ -2,9 +2,14 @@
 
 #include <cmath>
 #include <iostream>
+#include <numeric>
 #include <random>
+#include <set>
+#include <string>
 
+#include "ds/dsuf.hpp"
 #include "ds/graph.hpp"
+#include "ds/monotone_queue.hpp"
 
 using namespace P;
 using namespace std;
@@ -36,6 +41,60 @@ TEST_CASE("dijkstra's algorithm", "[graph]") {
   }
 }
 
+TEST_CASE("dijkstra queues and early exit", "[graph]") {
+  const int n = GENERATE(1, 2, 100, 2000);
+  const int maxw = GENERATE(0, 1, 9, 100000);
+  mt19937 gen(n + maxw);
+  uniform_int_distribution<> dis(0, n - 1), wdis(0, maxw);
+  WeightedAdjList al(n);
+  for (int q = 0; q < 3 * n; ++q) al[dis(gen)].push_back({dis(gen), wdis(gen)});
+  CAPTURE(n, maxw);
+
+  auto check = [&](auto& ws) {
+    for (int t = 0; t < 3; ++t) {  // the workspace is reused
+      int root = dis(gen), target = dis(gen);
+      auto exp = al.dijkstra(root);
+      al.dijkstra(ws, root);
+      REQUIRE(ws.dis == exp);
+      for (int v = 0; v < n; ++v) {
+        auto path = ws.path(v);
+        if (exp[v] == INF) {
+          REQUIRE(path.empty());
+          continue;
+        }
+        REQUIRE(path.front() == root);
+        REQUIRE(path.back() == v);
+        int len = 0;
+        for (int q = 0; q + 1 < (int)path.size(); ++q) {
+          int w = INF;
+          for (auto e : al[path[q]])
+            if (e.val == path[q + 1]) w = min(w, e.w);
+          len += w;
+        }
+        REQUIRE(len == exp[v]);
+      }
+      REQUIRE(al.dijkstra(ws, root, target) == exp[target]);
+      if (exp[target] != INF) REQUIRE(ws.path(target).back() == target);
+    }
+  };
+  SECTION("4-ary heap") {
+    DijkstraWorkspace<> ws;
+    check(ws);
+  }
+  SECTION("binary heap") {
+    DijkstraWorkspace<IndexedDaryHeap<2>> ws;
+    check(ws);
+  }
+  SECTION("radix heap") {
+    DijkstraWorkspace<RadixHeap> ws;
+    check(ws);
+  }
+  SECTION("dial buckets") {
+    DijkstraWorkspace<BucketQueue> ws(BucketQueue{maxw});
+    check(ws);
+  }
+}
+
 TEST_CASE("weighted graph", "[graph]") {
   int n = 64;
   WeightedAdjList al(n);
@@ -179,6 +238,42 @@ TEST_CASE("topological sort", "[graph]") {
   REQUIRE(al.is_topological_sort(seq));
 }
 
+TEST_CASE("topological levels", "[graph]") {
+  const int n = GENERATE(0, 1, 50, 5000);
+  mt19937 gen(n);
+  uniform_int_distribution<> dis(0, n - 1);
+  vector<int> perm(n);
+  iota(perm.begin(), perm.end(), 0);
+  shuffle(perm.begin(), perm.end(), gen);
+  AdjList al(n);
+  for (int q = 0; q < 3 * n; ++q) {
+    int a = dis(gen), b = dis(gen);
+    if (a != b) al[perm[min(a, b)]].push_back(perm[max(a, b)]);
+  }
+  vector<int> exp(n, 0);  // longest path ending at each vertex
+  al.topological_sort([&](Node u) {
+    for (auto v : al[u]) exp[v] = max(exp[v], exp[u] + 1);
+  });
+  for (int nthreads : {1, 3}) {
+    CAPTURE(n, nthreads);
+    auto levels = al.topological_levels(nthreads);
+    vector<int> level(n, -1);
+    for (int k = 0; k < (int)levels.size(); ++k) {
+      REQUIRE(is_sorted(levels[k].begin(), levels[k].end()));
+      for (int v : levels[k]) level[v] = k;
+    }
+    REQUIRE(level == exp);
+  }
+
+  if (n > 1) {
+    al[perm[0]].push_back(perm[n - 1]);
+    al[perm[n - 1]].push_back(perm[0]);
+    int cnt = 0;
+    for (auto const& l : al.topological_levels(3)) cnt += l.size();
+    REQUIRE(cnt < n);
+  }
+}
+
 TEST_CASE("is cyclic", "[graph]") {
   SECTION("cyclic case") {
     AdjList al(1);
@@ -215,6 +310,248 @@ TEST_CASE("is cyclic", "[graph]") {
   }
 }
 
+TEST_CASE("has cycle", "[graph]") {
+  const int n = GENERATE(1, 5, 40);
+  mt19937 gen(n);
+  uniform_int_distribution<> dis(0, n - 1), len(1, 6);
+  AdjList al(n);
+  for (int q = 0; q < 4 * n; ++q) al[dis(gen)].push_back(dis(gen));
+  auto mat = al.to_adjmat();
+  for (int q = 0; q < 500; ++q) {
+    vector<Node> path(len(gen));
+    for (auto& v : path) v = dis(gen);
+    CAPTURE(path);
+    REQUIRE(al.has_cycle(path) == mat.has_cycle(path));
+  }
+  REQUIRE_FALSE(al.has_cycle({}));
+}
+
+TEST_CASE("strongly connected components", "[graph]") {
+  const int n = GENERATE(1, 10, 100, 1000);
+  const int deg = GENERATE(1, 2);
+  mt19937 gen(n * deg);
+  uniform_int_distribution<> dis(0, n - 1);
+  AdjList al(n);
+  for (int q = 0; q < deg * n; ++q) al[dis(gen)].push_back(dis(gen));
+  auto comp = al.strongly_connected_components();
+  CAPTURE(n, deg);
+  for (int u = 0; u < n; ++u)
+    for (auto v : al[u]) REQUIRE(comp[u] >= comp[v]);
+  auto reach = al.to_bit_adjmat().transitive_closure();
+  for (int q = 0; q < 1000; ++q) {
+    int u = dis(gen), v = dis(gen);
+    bool same = u == v || (reach.test(u, v) && reach.test(v, u));
+    REQUIRE((comp[u] == comp[v]) == same);
+  }
+}
+
+TEST_CASE("parallel scc and condensation", "[graph]") {
+  const int n = GENERATE(0, 1, 10, 100, 5000);
+  const int deg = GENERATE(1, 2, 4);
+  mt19937 gen(n * deg);
+  uniform_int_distribution<> dis(0, max(n - 1, 0));
+  AdjList al(n);
+  for (int q = 0; q < deg * n; ++q) al[dis(gen)].push_back(dis(gen));
+  // a chain of small cycles on top
+  for (int u = 0; u + 3 < n; u += 3) {
+    al[u].push_back(u + 1);
+    al[u + 1].push_back(u);
+    al[u + 2].push_back(u + 3);
+  }
+
+  auto tarjan = al.strongly_connected_components();
+  auto same_partition = [n](vector<int> const& a, vector<int> const& b) {
+    vector<int> ab(n, -1), ba(n, -1);
+    for (int u = 0; u < n; ++u) {
+      if (ab[a[u]] == -1) ab[a[u]] = b[u];
+      if (ba[b[u]] == -1) ba[b[u]] = a[u];
+      if (ab[a[u]] != b[u] || ba[b[u]] != a[u]) return false;
+    }
+    return true;
+  };
+  for (int nthreads : {1, 3}) {
+    CAPTURE(n, deg, nthreads);
+    auto comp = al.parallel_scc(nthreads);
+    REQUIRE(same_partition(comp, tarjan));
+    for (int u = 0, next = 0; u < n; ++u) {  // by smallest vertex
+      REQUIRE(comp[u] <= next);
+      if (comp[u] == next) ++next;
+    }
+  }
+
+  auto dag = al.condense(tarjan);
+  const int C = n ? *max_element(tarjan.begin(), tarjan.end()) + 1 : 0;
+  REQUIRE(dag.N() == C);
+  REQUIRE_FALSE(dag.is_cyclic());
+  set<pair<int, int>> exp, got;
+  for (int u = 0; u < n; ++u)
+    for (auto v : al[u])
+      if (tarjan[u] != tarjan[v]) exp.insert({tarjan[u], tarjan[v]});
+  int m = 0;
+  for (int c = 0; c < C; ++c)
+    for (auto d : dag[c]) got.insert({c, d}), ++m;
+  REQUIRE(got == exp);
+  REQUIRE(m == (int)exp.size());
+}
+
+TEST_CASE("all-pairs reachability", "[graph]") {
+  const int n = GENERATE(0, 1, 63, 200, 700);
+  const int deg = GENERATE(1, 3);
+  mt19937 gen(n * deg);
+  uniform_int_distribution<> dis(0, max(n - 1, 0));
+  AdjList al(n), dag(n);
+  for (int q = 0; q < deg * n; ++q) {
+    int u = dis(gen), v = dis(gen);
+    al[u].push_back(v);
+    if (u < v) dag[u].push_back(v);
+  }
+  for (auto const* gr : {&al, &dag}) {
+    auto exp = gr->to_bit_adjmat().transitive_closure();
+    for (int nthreads : {1, 3}) {
+      CAPTURE(n, deg, nthreads);
+      REQUIRE(gr->reachability(nthreads) == exp);
+    }
+  }
+}
+
+TEST_CASE("floyd warshall", "[graph]") {
+  const int n = GENERATE(1, 2, 64, 150);
+  mt19937 gen(n);
+  uniform_int_distribution<> dis(0, n - 1), wdis(0, 1000);
+  WeightedAdjList al(n), dag(n);
+  for (int q = 0; q < 3 * n; ++q) {
+    int u = dis(gen), v = dis(gen), w = wdis(gen);
+    al[u].push_back({v, w});
+    if (u < v) dag[u].push_back({v, w - 500});
+  }
+  for (int nthreads : {1, 3}) {
+    CAPTURE(n, nthreads);
+    auto d = al.floyd_warshall(nthreads);
+    for (int u = 0; u < n; ++u) {
+      auto exp = al.dijkstra(u);
+      for (int v = 0; v < n; ++v) REQUIRE(d[{u, v}] == exp[v]);
+    }
+
+    // negative edges: a DAG relaxes its vertices in increasing order
+    auto dn = dag.floyd_warshall(nthreads);
+    for (int u = 0; u < n; ++u) {
+      vector<int> exp(n, INF);
+      exp[u] = 0;
+      for (int x = u; x < n; ++x)
+        if (exp[x] != INF)
+          for (auto [v, w] : dag[x]) exp[v] = min(exp[v], exp[x] + w);
+      for (int v = 0; v < n; ++v) REQUIRE(dn[{u, v}] == exp[v]);
+    }
+  }
+}
+
+TEST_CASE("minimum spanning forest", "[graph]") {
+  const int n = GENERATE(1, 2, 30, 1000, 20000);
+  const int deg = GENERATE(0, 1, 4);
+  const int maxw = GENERATE(3, 1000000);
+  mt19937 gen(n * deg + maxw);
+  uniform_int_distribution<> dis(0, n - 1), wdis(-maxw, maxw);
+  WeightedAdjList al(n);
+  for (int q = 0; q < deg * n; ++q) {
+    int u = dis(gen), v = dis(gen), w = wdis(gen);
+    al[u].push_back({v, w});
+    if (u != v) al[v].push_back({u, w});
+  }
+  CAPTURE(n, deg, maxw);
+
+  auto sorted = [](SpanningForest f) {
+    sort(f.edges.begin(), f.edges.end());
+    return f.edges;
+  };
+  auto k = al.kruskal();
+  auto p = al.prim();
+  REQUIRE(p.weight == k.weight);
+  REQUIRE(p.edges.size() == k.edges.size());
+  for (int nthreads : {1, 3}) {
+    auto b = al.boruvka(nthreads);
+    REQUIRE(b.weight == k.weight);
+    REQUIRE(sorted(b) == sorted(k));
+  }
+
+  // a spanning forest: one edge per merge, same components as the graph
+  DSUF dsuf(n);
+  long long sum = 0;
+  for (auto [u, v, w] : k.edges) {
+    REQUIRE(u < v);
+    REQUIRE_FALSE(dsuf.same_set(u, v));
+    dsuf.uni(u, v);
+    sum += w;
+  }
+  REQUIRE(sum == k.weight);
+  auto cc = al.connected_components_bfs();
+  for (int u = 0; u < n; ++u)
+    for (auto [v, w] : al[u]) REQUIRE(dsuf.same_set(u, v));
+  REQUIRE((int)k.edges.size() ==
+          n - (*max_element(cc.begin(), cc.end()) + 1));
+}
+
+TEST_CASE("vertex reordering", "[graph]") {
+  // 40 cliques of 6 vertices, a ring of cliques, under shuffled ids
+  const int k = 40, c = 6, n = k * c;
+  mt19937 gen(7);
+  vector<int> shuf(n);
+  iota(shuf.begin(), shuf.end(), 0);
+  shuffle(shuf.begin(), shuf.end(), gen);
+  WeightedAdjList al(n);
+  auto add = [&](int a, int b) {
+    al[shuf[a]].push_back({shuf[b], a + b});
+    al[shuf[b]].push_back({shuf[a], a + b});
+  };
+  for (int q = 0; q < k; ++q) {
+    for (int a = 0; a < c; ++a)
+      for (int b = a + 1; b < c; ++b) add(q * c + a, q * c + b);
+    add(q * c, (q + 1) % k * c + 1);
+  }
+  auto spread = [&al](vector<int> const& perm) {  // sum of |id differences|
+    long long s = 0;
+    for (int u = 0; u < al.N(); ++u)
+      for (auto e : al[u]) s += abs(perm[u] - perm[e.val]);
+    return s;
+  };
+  vector<int> id(n);
+  iota(id.begin(), id.end(), 0);
+
+  for (auto perm : {al.degree_order(), al.rcm_order(), al.community_order()}) {
+    REQUIRE(is_permutation(perm.begin(), perm.end(), id.begin()));
+    auto r = al.relabeled(perm);
+    for (int u = 0; u < n; ++u) {
+      REQUIRE(r[perm[u]].size() == al[u].size());
+      for (int q = 0; q < (int)al[u].size(); ++q) {
+        REQUIRE(r[perm[u]][q].val == perm[al[u][q].val]);
+        REQUIRE(r[perm[u]][q].w == al[u][q].w);
+      }
+    }
+    auto in_place = al;
+    in_place.relabel(perm);
+    for (int u = 0; u < n; ++u) REQUIRE(in_place[u] == r[u]);
+    auto d = al.dijkstra(0);
+    auto dr = r.dijkstra(perm[0]);
+    for (int u = 0; u < n; ++u) REQUIRE(dr[perm[u]] == d[u]);
+  }
+
+  auto deg = al.degree_order();
+  for (int u = 0; u < n; ++u)
+    for (int v = 0; v < n; ++v)
+      if (deg[u] < deg[v]) REQUIRE(al[u].size() >= al[v].size());
+  REQUIRE(spread(al.rcm_order()) * 4 < spread(id));
+  REQUIRE(spread(al.community_order()) * 4 < spread(id));
+
+  // path: rcm gives neighbors consecutive ids
+  AdjList path(n);
+  for (int q = 0; q + 1 < n; ++q) {
+    path[shuf[q]].push_back(shuf[q + 1]);
+    path[shuf[q + 1]].push_back(shuf[q]);
+  }
+  auto rcm = path.rcm_order();
+  for (int u = 0; u < n; ++u)
+    for (int v : path[u]) REQUIRE(abs(rcm[u] - rcm[v]) == 1);
+}
+
 TEST_CASE("is functional", "[graph]") {
   const int n = GENERATE(0, 1, 2, 3, 4, 33, 128);
   CAPTURE(n);
@@ -263,3 +600,278 @@ TEST_CASE("functional graph find cycle", "[graph]") {
     REQUIRE(res.size() == 2);
   }
 }
+
+TEST_CASE("functional graph cycles", "[graph]") {
+  const int n = GENERATE(0, 1, 2, 7, 300, 100'000);
+  CAPTURE(n);
+  mt19937 gen(n);
+  uniform_int_distribution<> dis(0, max(n - 1, 0));
+  FunctionalGraph g(n);
+  for (int v = 0; v < n; ++v)  // self loops, short cycles and long tails
+    g[v] = gen() % 20 == 0 ? v : gen() % 2 ? dis(gen) : max(v - 1, 0);
+
+  auto res = g.cycles();
+  REQUIRE(res.cycle.size() == size_t(n));
+  REQUIRE(res.tail.size() == size_t(n));
+  int next_id = 0;
+  for (int v = 0; v < n; ++v) {
+    int c = res.cycle[v];
+    REQUIRE(c <= next_id);  // numbered by smallest vertex reaching them
+    if (c == next_id) ++next_id;
+    if (res.tail[v] > 0) {
+      REQUIRE(res.tail[g[v]] == res.tail[v] - 1);
+      REQUIRE(res.cycle[g[v]] == c);
+    } else {
+      int x = g[v], l = 1;
+      for (; x != v && l <= n; x = g[x], ++l) REQUIRE(res.tail[x] == 0);
+      REQUIRE(l == res.len[c]);
+    }
+  }
+  REQUIRE(next_id == (int)res.len.size());
+
+  auto par = g.parallel_cycles(3);
+  REQUIRE(par.cycle == res.cycle);
+  REQUIRE(par.tail == res.tail);
+  REQUIRE(par.len == res.len);
+
+  auto walk = [&g](int v, long long k) {
+    while (k--) v = g[v];
+    return v;
+  };
+  auto table = g.jump_table(1000, 3);
+  for (long long k : {0, 1, 5, 64, 999, 1000, 2345}) {
+    CAPTURE(k);
+    auto succ = g.successors(k, 3);
+    for (int v = 0; v < n; v += 1 + v / 8) {
+      REQUIRE(succ[v] == walk(v, k));
+      REQUIRE(table.jump(v, k) == succ[v]);
+    }
+  }
+  for (long long k : {1'000'000'000'000LL, (1LL << 62) + 12345}) {
+    CAPTURE(k);  // reduced around the cycles
+    auto succ = g.successors(k, 3);
+    for (int v = 0; v < n; v += 1 + v / 8)
+      REQUIRE(table.jump(v, k) == succ[v]);
+  }
+}
+
+TEST_CASE("connected components", "[graph]") {
+  const int n = GENERATE(0, 1, 2, 50, 3000);
+  const int m = GENERATE(0, 1, 10, 2000);
+  mt19937 gen(n + m);
+  uniform_int_distribution<> dis(0, max(n - 1, 0));
+  AdjList al(n);
+  if (n > 0)
+    for (int q = 0; q < m; ++q) {
+      int u = dis(gen), v = dis(gen);
+      al[u].push_back(v);
+      al[v].push_back(u);
+    }
+  auto exp = al.connected_components_bfs();
+  for (int nthreads : {1, 3, 8}) {
+    CAPTURE(n, m, nthreads);
+    REQUIRE(al.connected_components(nthreads) == exp);
+  }
+  if (n == 50 && m == 10) {
+    DSUF d(n);
+    for (int u = 0; u < n; ++u)
+      for (auto v : al[u]) d.uni(u, v);
+    for (int u = 0; u < n; ++u)
+      for (int v = 0; v < n; ++v)
+        REQUIRE(d.same_set(u, v) == (exp[u] == exp[v]));
+  }
+}
+
+TEST_CASE("parallel bfs", "[graph]") {
+  const int n = GENERATE(1, 2, 64, 65, 3000);
+  const int deg = GENERATE(0, 1, 8);
+  mt19937 gen(n * 10 + deg);
+  uniform_int_distribution<> dis(0, n - 1);
+  AdjList al(n);
+  for (int q = 0; q < n * deg; ++q) {
+    int u = dis(gen), v = dis(gen);
+    al[u].push_back(v);
+    al[v].push_back(u);
+  }
+  for (int u = 0; u + 1 < n && deg == 0; ++u) {  // path
+    al[u].push_back(u + 1);
+    al[u + 1].push_back(u);
+  }
+  int root = dis(gen);
+  vector<int> exp(n, -1);
+  al.bfs_depth(root, [&exp](Node x, int d) { exp[x] = d; });
+  for (int nthreads : {1, 3, 8}) {
+    CAPTURE(n, deg, nthreads);
+    auto [depth, parent] = al.parallel_bfs(root, nthreads);
+    REQUIRE(depth == exp);
+    REQUIRE(parent[root] == root);
+    for (int v = 0; v < n; ++v) {
+      if (v == root || depth[v] == -1) {
+        REQUIRE((v == root || parent[v] == -1));
+        continue;
+      }
+      int u = parent[v];
+      REQUIRE(depth[u] == depth[v] - 1);
+      REQUIRE(find(al[u].begin(), al[u].end(), Node(v)) != al[u].end());
+    }
+  }
+}
+
+TEST_CASE("point-to-point shortest paths", "[graph]") {
+  const int n = GENERATE(1, 2, 50, 1000);
+  const bool directed = GENERATE(false, true);
+  mt19937 gen(n + directed);
+  uniform_int_distribution<> dis(0, n - 1), wdis(0, 50);
+  WeightedAdjList al(n);
+  for (int q = 0; q < 2 * n; ++q) {
+    int u = dis(gen), v = dis(gen), w = wdis(gen);
+    al[u].push_back({v, w});
+    if (!directed) al[v].push_back({u, w});
+  }
+  auto rev = al.transpose();
+  AltHeuristic alt(al, rev, AltHeuristic::farthest_landmarks(al, 4));
+  BidirectionalWorkspace bws;
+  DijkstraWorkspace<> ws;
+  DijkstraWorkspace<RadixHeap> rws;
+  CAPTURE(n, directed);
+
+  for (int t = 0; t < 20; ++t) {
+    int s = dis(gen), target = dis(gen);
+    auto exp = al.dijkstra(s);
+    CAPTURE(s, target);
+    auto check_path = [&](vector<int> const& path) {
+      if (exp[target] == INF) {
+        REQUIRE(path.empty());
+        return;
+      }
+      REQUIRE(path.front() == s);
+      REQUIRE(path.back() == target);
+      int len = 0;
+      for (int q = 0; q + 1 < (int)path.size(); ++q) {
+        int w = INF;
+        for (auto e : al[path[q]])
+          if (e.val == path[q + 1]) w = min(w, e.w);
+        len += w;
+      }
+      REQUIRE(len == exp[target]);
+    };
+
+    REQUIRE(al.bidirectional_dijkstra(rev, bws, s, target) == exp[target]);
+    check_path(bws.path());
+
+    auto zero = [](int) { return 0; };
+    REQUIRE(al.astar(ws, s, target, zero) == exp[target]);
+    check_path(ws.path(target));
+
+    auto h = [&](int v) { return alt(v, target); };
+    for (int v = 0; v < n; ++v) {
+      int d = al.dijkstra(v)[target];
+      if (d == INF) continue;
+      REQUIRE(h(v) <= d);  // admissible
+      for (auto [u, w] : al[v]) REQUIRE(h(v) <= w + h(u));  // consistent
+    }
+    REQUIRE(al.astar(ws, s, target, h) == exp[target]);
+    check_path(ws.path(target));
+    REQUIRE(al.astar(rws, s, target, h) == exp[target]);
+    if (n > 50) break;  // the admissibility check is quadratic
+  }
+}
+
+TEST_CASE("astar on a grid", "[graph]") {
+  const int side = 30;
+  WeightedAdjList al(side * side);
+  mt19937 gen(side);
+  uniform_int_distribution<> wdis(1, 9);
+  for (int y = 0; y < side; ++y)
+    for (int x = 0; x < side; ++x) {
+      int u = y * side + x;
+      if (x + 1 < side) al[u].push_back({u + 1, wdis(gen)});
+      if (y + 1 < side) al[u].push_back({u + side, wdis(gen)});
+      if (x > 0) al[u].push_back({u - 1, wdis(gen)});
+      if (y > 0) al[u].push_back({u - side, wdis(gen)});
+    }
+  DijkstraWorkspace<> ws;
+  int t = side * side - 1;
+  auto manhattan = [t](int v) {  // weights >= 1
+    return abs(v / side - t / side) + abs(v % side - t % side);
+  };
+  REQUIRE(al.astar(ws, 0, t, manhattan) == al.dijkstra(0)[t]);
+}
+
+TEST_CASE("delta stepping", "[graph]") {
+  const int n = GENERATE(1, 2, 100, 3000);
+  const int maxw = GENERATE(0, 1, 10, 100000);
+  mt19937 gen(n + maxw);
+  uniform_int_distribution<> dis(0, n - 1), wdis(0, maxw);
+  WeightedAdjList al(n);
+  for (int q = 0; q < 4 * n; ++q) al[dis(gen)].push_back({dis(gen), wdis(gen)});
+  int root = dis(gen);
+  auto exp = al.dijkstra(root);
+  for (int delta : {0, 1, 7, 1000})
+    for (int nthreads : {1, 3}) {
+      CAPTURE(n, maxw, delta, nthreads);
+      REQUIRE(al.delta_stepping(root, delta, nthreads) == exp);
+    }
+}
+
+TEST_CASE("delta stepping with large weights and a tiny delta", "[graph]") {
+  WeightedAdjList al(3);
+  al[0].push_back({1, 1'000'000'000});
+  al[0].push_back({2, 3});
+  al[2].push_back({1, 5});
+  for (int nthreads : {1, 3})
+    REQUIRE(al.delta_stepping(0, 1, nthreads) == vector<int>{0, 8, 3});
+  WeightedAdjList far(2);
+  far[0].push_back({1, 1'000'000'000});
+  REQUIRE(far.delta_stepping(0, 1) == vector<int>{0, 1'000'000'000});
+}
+
+TEST_CASE("iterative dfs", "[graph]") {
+  SECTION("deep path") {
+    const int n = 1'000'000;
+    AdjList al(n);
+    for (int u = 0; u + 1 < n; ++u) al[u].push_back(u + 1);
+    TraversalWorkspace ws;
+    long long sum = 0;
+    al.dfs(ws, 0, [&sum](Node x) { sum += x; });
+    REQUIRE(sum == (long long)n * (n - 1) / 2);
+    al.dfs_dtree(ws, 0, [&sum](Node x) { sum -= x; });
+    REQUIRE(sum == 0);
+    REQUIRE_FALSE(al.is_cyclic(ws));
+    REQUIRE(al.find_cycle(ws).empty());
+    al[n - 1].push_back(0);
+    REQUIRE(al.is_cyclic(ws));
+    REQUIRE(al.find_cycle(ws).size() == n);
+  }
+
+  SECTION("edge classification") {
+    AdjList al(5);
+    for (auto [u, v] : vector<pair<int, int>>{
+             {0, 1}, {1, 2}, {2, 0}, {0, 2}, {3, 2}, {3, 4}})
+      al[u].push_back(v);
+    struct Log : DfsVisitor {
+      vector<string> ev;
+      void pre(int u) { ev.push_back("pre " + to_string(u)); }
+      void post(int u) { ev.push_back("post " + to_string(u)); }
+      void tree_edge(int u, int v) { add("tree", u, v); }
+      void back_edge(int u, int v) { add("back", u, v); }
+      void forward_or_cross_edge(int u, int v) { add("other", u, v); }
+      void add(string s, int u, int v) {
+        ev.push_back(s + ' ' + to_string(u) + to_string(v));
+      }
+    } log;
+    TraversalWorkspace ws;
+    ws.reset(al.N());
+    for (int u = 0; u < al.N(); ++u)
+      if (ws.white(u)) al.dfs_visit(ws, u, log);
+    vector<string> exp{"pre 0",    "tree 01",  "pre 1",    "tree 12",
+                       "pre 2",    "back 20",  "post 2",   "post 1",
+                       "other 02", "post 0",   "pre 3",    "other 32",
+                       "tree 34",  "pre 4",    "post 4",   "post 3"};
+    REQUIRE(log.ev == exp);
+    for (int u = 0; u < al.N(); ++u) REQUIRE(ws.black(u));
+
+    ws.reset(al.N());  // new epoch: everything white again
+    for (int u = 0; u < al.N(); ++u) REQUIRE(ws.white(u));
+  }
+}
@@ -0,0 +1,83 @@
+#include <catch2/catch.hpp>
+
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "ds/graph.hpp"
+#include "ds/heavy_light.hpp"
+
+using namespace P;
+using namespace std;
+
+TEST_CASE("heavy light decomposition", "[graph]") {
+  // 0 -> 1 2 3, 1 -> 4 5, 3 -> 6, 4 -> 7
+  AdjList al(8);
+  al[0] = {1, 2, 3};
+  al[1] = {4, 5};
+  al[3] = {6};
+  al[4] = {7};
+  HeavyLight hl(al, 0);
+  REQUIRE(hl.N() == 8);
+  // heavy path 0 1 4 7 first, then the light subtrees
+  REQUIRE(hl.position(0) == 0);
+  for (int v : {1, 4, 7})
+    REQUIRE(hl.position(v) == hl.position(hl.parent(v)) + 1);
+  REQUIRE(hl.subtree(0) == pair{0, 8});
+  REQUIRE(hl.subtree(1) == pair{1, 5});
+  REQUIRE(hl.subtree(3).second - hl.subtree(3).first == 2);
+  REQUIRE(hl.depth(7) == 3);
+  REQUIRE(hl.lca(7, 5) == 1);
+  REQUIRE(hl.lca(7, 6) == 0);
+  REQUIRE(hl.dist(7, 6) == 5);
+
+  vector<int> cnt;
+  auto count = [&](int b, int e) { cnt.push_back(e - b); };
+  hl.path(7, 6, count);
+  REQUIRE(accumulate(cnt.begin(), cnt.end(), 0) == 6);
+  cnt.clear();
+  hl.path(7, 6, count, true);
+  REQUIRE(accumulate(cnt.begin(), cnt.end(), 0) == 5);
+  cnt.clear();
+  hl.path(2, 2, count, true);
+  REQUIRE(cnt.empty());
+}
+
+TEST_CASE("heavy light path sums", "[graph]") {
+  const int n = GENERATE(1, 2, 100, 3000);
+  CAPTURE(n);
+  mt19937 gen(n);
+  AdjList al(n);
+  vector<int> par(n);
+  for (int v = 1; v < n; ++v) {
+    par[v] = gen() % 2 ? v - 1 : gen() % v;
+    al[par[v]].push_back(v);
+  }
+  vector<long long> val(n);
+  for (auto& x : val) x = gen() % 1000;
+  HeavyLight hl(al, 0);
+  auto by_pos = hl.by_position(val);
+  vector<long long> pre(n + 1), sub = val;
+  for (int i = 0; i < n; ++i) pre[i + 1] = pre[i] + by_pos[i];
+  for (int v = n - 1; v > 0; --v) sub[par[v]] += sub[v];
+
+  for (int q = 0; q < 500; ++q) {
+    int u = gen() % n, v = gen() % n, l = hl.lca(u, v);
+    long long exp = val[l];
+    for (int x = u; x != l; x = par[x]) exp += val[x];
+    for (int x = v; x != l; x = par[x]) exp += val[x];
+    long long sum = 0, ranges = 0;
+    hl.path(u, v, [&](int b, int e) {
+      sum += pre[e] - pre[b];
+      ++ranges;
+    });
+    REQUIRE(sum == exp);
+    REQUIRE(ranges <= 2 * 12 + 1);  // 2 log2(n) + 1
+    sum = 0;
+    hl.path(u, v, [&](int b, int e) { sum += pre[e] - pre[b]; }, true);
+    REQUIRE(sum == exp - val[l]);
+
+    auto [b, e] = hl.subtree(u);
+    REQUIRE(pre[e] - pre[b] == sub[u]);
+  }
+}
@@ -0,0 +1,66 @@
+#include <catch2/catch.hpp>
+
+#include "algo/kway_merge.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <random>
+
+using namespace std;
+using namespace P;
+
+TEST_CASE("merge_branchless", "[kway_merge]") {
+  mt19937 gen(1);
+  uniform_int_distribution dis(0, 20);
+  int n = GENERATE(0, 1, 2, 17, 1 << 8);
+  int m = GENERATE(0, 1, 33);
+  vector<pair<int, int>> a(n), b(m);  // key, origin
+  for (auto& e : a) e = {dis(gen), 0};
+  for (auto& e : b) e = {dis(gen), 1};
+  sort(begin(a), end(a));
+  sort(begin(b), end(b));
+  vector<pair<int, int>> res, exp;
+  merge_branchless(begin(a), end(a), begin(b), end(b), back_inserter(res),
+                   less<>(), &pair<int, int>::first);
+  merge(begin(a), end(a), begin(b), end(b), back_inserter(exp),
+        [](auto x, auto y) { return x.first < y.first; });
+  REQUIRE(res == exp);
+}
+
+TEST_CASE("kway_merge", "[kway_merge]") {
+  mt19937 gen(2);
+  uniform_int_distribution dis(0, 50);
+  int k = GENERATE(0, 1, 2, 3, 7, 64, 100);
+  vector<vector<pair<int, int>>> shards(k);  // key, shard
+  vector<pair<int, int>> exp;
+  for (int i = 0; i < k; ++i) {
+    shards[i].resize(gen() % 40);
+    for (auto& e : shards[i]) e = {dis(gen), i};
+    sort(begin(shards[i]), end(shards[i]));
+    exp.insert(end(exp), begin(shards[i]), end(shards[i]));
+  }
+  stable_sort(begin(exp), end(exp),
+              [](auto x, auto y) { return x.first < y.first; });
+  DYNAMIC_SECTION(k << " shards") {
+    vector<pair<int, int>> res;
+    kway_merge(shards, back_inserter(res), less<>(), &pair<int, int>::first);
+    REQUIRE(res == exp);
+  }
+  DYNAMIC_SECTION(k << " deque ranges, descending") {
+    vector<deque<int>> ds(k);
+    vector<int> all;
+    for (int i = 0; i < k; ++i) {
+      for (auto [key, _] : shards[i]) ds[i].push_front(key);
+      all.insert(end(all), begin(ds[i]), end(ds[i]));
+    }
+    sort(begin(all), end(all), greater<>());
+    using It = deque<int>::iterator;
+    vector<pair<It, It>> ranges;
+    for (auto& d : ds) ranges.push_back({begin(d), end(d)});
+    vector<int> res(all.size());
+    auto it = kway_merge(ranges, begin(res), greater<>());
+    REQUIRE(it == end(res));
+    REQUIRE(res == all);
+  }
+}
@@ -0,0 +1,98 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ds/csr_graph.hpp"
+#include "ds/graph.hpp"
+#include "ds/heavy_light.hpp"
+#include "ds/lca.hpp"
+
+using namespace P;
+using namespace std;
+
+// random tree under shuffled ids; chain = probability to extend the last
+// vertex (deep trees)
+AdjList<> random_tree(int n, double chain, mt19937& gen, int& root) {
+  vector<int> id(n);
+  iota(id.begin(), id.end(), 0);
+  shuffle(id.begin(), id.end(), gen);
+  bernoulli_distribution ext(chain);
+  AdjList al(n);
+  for (int v = 1; v < n; ++v) {
+    int p = ext(gen) ? v - 1 : uniform_int_distribution<>(0, v - 1)(gen);
+    al[id[p]].push_back(id[v]);
+  }
+  root = id[0];
+  return al;
+}
+
+int naive_lca(RootedTree const& t, int u, int v) {
+  while (t.depth[u] > t.depth[v]) u = t.parent[u];
+  while (t.depth[v] > t.depth[u]) v = t.parent[v];
+  while (u != v) u = t.parent[u], v = t.parent[v];
+  return u;
+}
+
+TEST_CASE("rooted tree", "[graph]") {
+  AdjList al(5);
+  al[2] = {0, 4};
+  al[0] = {1, 3};
+  RootedTree t(al, 2);
+  REQUIRE(t.parent == vector<int>{2, 0, 2, 0, 2});
+  REQUIRE(t.depth == vector<int>{1, 2, 0, 2, 1});
+  REQUIRE(t.order == vector<int>{2, 4, 0, 3, 1});
+  REQUIRE(RootedTree(AdjList(0), 0).N() == 0);
+
+  REQUIRE_THROWS_AS(RootedTree(al, 0), invalid_argument);  // 2, 4 missed
+  al[3] = {1};
+  REQUIRE_THROWS_AS(RootedTree(al, 2), invalid_argument);  // 1 twice
+  al[3] = {2};
+  REQUIRE_THROWS_AS(RootedTree(al, 2), invalid_argument);  // cycle
+}
+
+TEST_CASE("lowest common ancestor", "[graph]") {
+  const int n = GENERATE(1, 2, 3, 63, 64, 65, 200, 5000);
+  const double chain = GENERATE(0.0, 0.5, 1.0);
+  CAPTURE(n, chain);
+  mt19937 gen(n);
+  int root;
+  auto al = random_tree(n, chain, gen, root);
+  RootedTree t(al, root);
+  EulerTourLca et(t);
+  BinaryLiftingLca bl(CsrGraph<>(al), root, 3);
+  HeavyLight hl(al, root);
+  REQUIRE(et.N() == n);
+  REQUIRE(bl.N() == n);
+
+  uniform_int_distribution<> dis(0, n - 1);
+  vector<pair<int, int>> queries;
+  for (int q = 0; q < 2000; ++q) queries.push_back({dis(gen), dis(gen)});
+  queries.push_back({root, root});
+  queries.push_back({0, 0});
+  auto offline = tarjan_lca(al, root, queries);
+  for (int i = 0; i < (int)queries.size(); ++i) {
+    auto [u, v] = queries[i];
+    CAPTURE(u, v);
+    int exp = naive_lca(t, u, v);
+    REQUIRE(et.lca(u, v) == exp);
+    REQUIRE(bl.lca(u, v) == exp);
+    REQUIRE(hl.lca(u, v) == exp);
+    REQUIRE(offline[i] == exp);
+    int d = t.depth[u] + t.depth[v] - 2 * t.depth[exp];
+    REQUIRE(et.dist(u, v) == d);
+    REQUIRE(bl.dist(u, v) == d);
+    REQUIRE(hl.dist(u, v) == d);
+  }
+
+  for (int q = 0; q < 200; ++q) {
+    int v = dis(gen), k = dis(gen), x = v;
+    for (int i = 0; i < k; ++i) x = t.parent[x];
+    REQUIRE(bl.ancestor(v, k) == x);
+  }
+  REQUIRE(tarjan_lca(al, root, {}).empty());
+}
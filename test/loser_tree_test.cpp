@@ -0,0 +1,34 @@
+#include <catch2/catch.hpp>
+
+#include "algo/loser_tree.hpp"
+
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace P;
+
+TEST_CASE("loser tree", "[loser_tree]") {
+  vector<vector<int>> seqs{{1, 4, 7}, {}, {2, 2, 9}, {0}, {3, 4}};
+  int k = seqs.size();
+  LoserTree<int> lt(k);
+  vector<size_t> pos(k);
+  for (int i = 0; i < k; ++i)
+    if (seqs[i].empty())
+      lt.set_exhausted(i);
+    else
+      lt.set(i, seqs[i][0]);
+  lt.build();
+  vector<pair<int, int>> res;  // key, sequence
+  while (!lt.empty()) {
+    int i = lt.winner();
+    res.push_back({lt.winner_key(), i});
+    if (++pos[i] == seqs[i].size())
+      lt.pop();
+    else
+      lt.replace(seqs[i][pos[i]]);
+  }
+  vector<pair<int, int>> exp{{0, 3}, {1, 0}, {2, 2}, {2, 2}, {3, 4},
+                             {4, 0}, {4, 4}, {7, 0}, {9, 2}};
+  REQUIRE(res == exp);
+}
@@ -3,6 +3,7 @@
 #include "algo/merge_sort.hpp"
 
 #include <algorithm>
+#include <deque>
 
 using namespace std;
 using namespace P;
@@ -49,3 +50,17 @@ TEST_CASE("merge_sort", "[merge_sort]") {
     }
   }
 }
+
+TEST_CASE("merge_sort generic", "[merge_sort]") {
+  mt19937 gen(5);
+  uniform_int_distribution dis(0, 5);
+  int n = GENERATE(0, 1, 2, 3, 17, 1 << 8, (1 << 8) + 1);
+  deque<pair<int, int>> d;
+  for (int q = 0; q < n; ++q) d.push_back({dis(gen), q});
+  DYNAMIC_SECTION(n << " pairs, stable by first") {
+    merge_sort(begin(d), end(d), greater<>(), &pair<int, int>::first);
+    REQUIRE(is_sorted(begin(d), end(d), [](auto a, auto b) {
+      return a.first > b.first || (a.first == b.first && a.second < b.second);
+    }));
+  }
+}
@@ -0,0 +1,39 @@
+#include <catch2/catch.hpp>
+
+#include "ds/monotone_queue.hpp"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace std;
+using namespace P;
+
+TEMPLATE_TEST_CASE("monotone queue", "[monotone_queue]", RadixHeap,
+                   BucketQueue) {
+  const int spread = GENERATE(1, 7, 1000);
+  mt19937 gen(spread);
+  uniform_int_distribution<> dis(0, spread);
+  TestType q(spread);
+  for (int round = 0; round < 2; ++round) {
+    q.clear();
+    multiset<pair<int, int>> ref;
+    int last = 0;
+    for (int t = 0; t < 5000; ++t) {
+      if (gen() % 2 && !q.empty()) {
+        auto [k, v] = q.pop();
+        REQUIRE(k == ref.begin()->first);
+        REQUIRE(ref.count({k, v}));
+        ref.erase(ref.find({k, v}));
+        REQUIRE(k >= last);
+        last = k;
+      } else {
+        int k = last + dis(gen);
+        q.push(t, k);
+        ref.insert({k, t});
+      }
+      REQUIRE(q.size() == (int)ref.size());
+    }
+  }
+}
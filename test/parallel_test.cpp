@@ -0,0 +1,38 @@
+#include <catch2/catch.hpp>
+
+#include "util/parallel.hpp"
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace P;
+
+TEST_CASE("run_threads", "[parallel]") {
+  const int nthreads = GENERATE(1, 2, 7);
+  vector<int> ran(nthreads);
+  run_threads(nthreads, [&](int t) { ++ran[t]; });
+  REQUIRE(ran == vector<int>(nthreads, 1));
+}
+
+TEST_CASE("parallel_for", "[parallel]") {
+  // n * nthreads > INT_MAX for the last one: every index must still run once
+  auto [n, nthreads] = GENERATE(table<int, int>(
+      {{0, 4}, {1, 4}, {3, 8}, {1000, 7}, {100'000'000, 32}}));
+  CAPTURE(n, nthreads);
+  struct alignas(64) Slot {
+    atomic<long long> cnt{0}, sum{0};
+  };
+  vector<Slot> slots(64);  // per thread, shared only on a hash collision
+  parallel_for(0, n, [&](int i) {
+    auto& s = slots[hash<thread::id>()(this_thread::get_id()) % slots.size()];
+    s.cnt.fetch_add(1, memory_order_relaxed);
+    s.sum.fetch_add(i, memory_order_relaxed);
+  }, nthreads);
+  long long cnt = 0, sum = 0;
+  for (auto& s : slots) cnt += s.cnt, sum += s.sum;
+  REQUIRE(cnt == n);
+  REQUIRE(sum == (long long)n * (n - 1) / 2);
+}
@@ -4,6 +4,8 @@
 
 #include <algorithm>
 #include <climits>
+#include <deque>
+#include <numeric>
 
 using namespace std;
 using namespace P;
@@ -106,3 +108,45 @@ TEST_CASE("quick_select e1", "[quick_select]") {
   nth_element(begin(v), begin(v) + k, end(v));
   REQUIRE(res == v[k]);
 }
+
+TEST_CASE("quick_nth", "[quick_select]") {
+  mt19937 gen;
+  uniform_int_distribution dis(0, 10);
+  vector<int> v;
+  int n = GENERATE(1, 2, 3, 4, 15, 16, 17, 18, 19, 20, 1 << 8);
+  gen.seed(n);
+  generate_n(back_inserter(v), n, [&dis, &gen]() { return dis(gen); });
+  auto exp = v;
+  sort(begin(exp), end(exp));
+  for (int k = 0; k < n; ++k) {
+    DYNAMIC_SECTION(n << " elements, k = " << k) {
+      quick_nth(begin(v), begin(v) + k, end(v));
+      CAPTURE(v);
+      REQUIRE(v[k] == exp[k]);
+      REQUIRE(all_of(begin(v), begin(v) + k, [&](int e) { return e <= v[k]; }));
+      REQUIRE(all_of(begin(v) + k, end(v), [&](int e) { return e >= v[k]; }));
+    }
+  }
+  SECTION("sorted input") {
+    vector<int> w(n);
+    iota(begin(w), end(w), 0);
+    quick_nth(begin(w), begin(w) + n / 2, end(w));
+    REQUIRE(w[n / 2] == n / 2);
+  }
+}
+
+TEST_CASE("quick_select generic", "[quick_select]") {
+  mt19937 gen(3);
+  deque<int> d;
+  int n = GENERATE(1, 2, 3, 17, 1 << 8);
+  generate_n(back_inserter(d), n, gen);
+  auto exp = vector(begin(d), end(d));
+  sort(begin(exp), end(exp), greater<>());
+  for (int k : {0, n / 2, n - 1}) {
+    auto it = quick_select(begin(d), end(d), k, greater<>());
+    REQUIRE(*it == exp[k]);
+    quick_nth(begin(d), begin(d) + k, end(d), less<>(),
+              [](int x) { return -x; });
+    REQUIRE(d[k] == exp[k]);
+  }
+}
@@ -3,6 +3,8 @@
 #include "algo/quick_sort.hpp"
 
 #include <algorithm>
+#include <deque>
+#include <numeric>
 
 using namespace std;
 using namespace P;
@@ -26,3 +28,59 @@ TEST_CASE("quick_sort", "[quick_sort]") {
     }
   }
 }
+
+TEST_CASE("partial_quick_sort", "[quick_sort]") {
+  mt19937 gen;
+  uniform_int_distribution dis(0, 10);
+  vector<int> v;
+  int n = GENERATE(0, 1, 2, 3, 4, 15, 16, 17, 18, 19, 20, 1 << 8);
+  gen.seed(n);
+  generate_n(back_inserter(v), n, [&dis, &gen]() { return dis(gen); });
+  auto exp = v;
+  sort(begin(exp), end(exp));
+  int k = GENERATE(0, 1, 2, 5, 16, 1 << 8);
+  DYNAMIC_SECTION(n << " elements, k = " << k) {
+    partial_quick_sort(v, k);
+    k = min(k, n);
+    REQUIRE(equal(begin(v), begin(v) + k, begin(exp)));
+    auto rest = vector(begin(v) + k, end(v));
+    sort(begin(rest), end(rest));
+    REQUIRE(equal(begin(rest), end(rest), begin(exp) + k));
+  }
+}
+
+TEST_CASE("quick_sort generic", "[quick_sort]") {
+  mt19937 gen(7);
+  uniform_int_distribution dis(0, 50);
+  int n = GENERATE(0, 1, 2, 3, 17, 1 << 8);
+  SECTION("deque with comparator") {
+    deque<int> d;
+    generate_n(back_inserter(d), n, [&dis, &gen]() { return dis(gen); });
+    auto d2 = d;
+    quick_sort(begin(d), end(d), greater<>());
+    REQUIRE(is_sorted(begin(d), end(d), greater<>()));
+    quick_sort2(begin(d2), end(d2), greater<>());
+    REQUIRE(d == d2);
+  }
+  SECTION("raw array with projection") {
+    struct R {
+      int key;
+      int payload;
+    };
+    vector<R> v;
+    generate_n(back_inserter(v), n,
+               [&dis, &gen]() { return R{dis(gen), dis(gen)}; });
+    R* p = v.data();
+    quick_sort2(p, p + n, less<>(), &R::key);
+    REQUIRE(is_sorted(p, p + n, [](R a, R b) { return a.key < b.key; }));
+    partial_quick_sort(p, p + n / 2, p + n, greater<>(), &R::payload);
+    REQUIRE(is_sorted(p, p + n / 2,
+                      [](R a, R b) { return a.payload > b.payload; }));
+  }
+  SECTION("sorted input") {
+    vector<int> v(n);
+    iota(begin(v), end(v), 0);
+    quick_sort2(begin(v), end(v));
+    REQUIRE(is_sorted(begin(v), end(v)));
+  }
+}
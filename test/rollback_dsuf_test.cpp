@@ -0,0 +1,59 @@
+#include <catch2/catch.hpp>
+
+#include "ds/dsuf.hpp"
+#include "ds/rollback_dsuf.hpp"
+
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace std;
+using namespace P;
+
+TEST_CASE("rollback dsuf", "[rollback_dsuf]") {
+  RollbackDSUF d(5);
+  REQUIRE(d.uni(0, 1));
+  auto s = d.snapshot();
+  REQUIRE(d.uni(2, 3));
+  REQUIRE(d.uni(1, 3));
+  REQUIRE_FALSE(d.uni(0, 2));
+  REQUIRE(d.size(0) == 4);
+  REQUIRE(d.count() == 2);
+  d.rollback(s);
+  REQUIRE(d.same_set(0, 1));
+  REQUIRE_FALSE(d.same_set(1, 2));
+  REQUIRE_FALSE(d.same_set(2, 3));
+  REQUIRE(d.size(0) == 2);
+  REQUIRE(d.count() == 4);
+  d.rollback(0);
+  REQUIRE(d.count() == 5);
+}
+
+TEST_CASE("offline dynamic connectivity", "[rollback_dsuf]") {
+  const int n = GENERATE(1, 2, 8, 40);
+  const int T = 600;
+  mt19937 gen(n);
+  uniform_int_distribution<> dis(0, n - 1);
+  DynamicConnectivity dc(n);
+  multiset<pair<int, int>> present;
+  vector<bool> exp;
+  for (int t = 0; t < T; ++t) {
+    int u = dis(gen), v = dis(gen);
+    int op = gen() % 3;
+    if (op == 1 && !present.empty()) {
+      auto it = next(begin(present), gen() % present.size());
+      auto [a, b] = *it;
+      present.erase(it);
+      dc.remove_edge(b, a);
+    } else if (op == 0) {
+      present.insert({u, v});
+      dc.add_edge(u, v);
+    } else {
+      DSUF d(n);
+      for (auto [a, b] : present) d.uni(a, b);
+      exp.push_back(d.same_set(u, v));
+      dc.query(u, v);
+    }
+  }
+  REQUIRE(dc.solve() == exp);
+}
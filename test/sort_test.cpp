@@ -0,0 +1,38 @@
+#include <catch2/catch.hpp>
+
+#include "algo/sort.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <string>
+
+using namespace std;
+using namespace P;
+
+TEST_CASE("sort_range", "[sort]") {
+  struct R {
+    int key;
+    string name;
+  };
+  mt19937 gen(11);
+  uniform_int_distribution dis(0, 9);
+  int n = GENERATE(0, 1, 2, 33, 1 << 9);
+  deque<R> d;
+  for (int q = 0; q < n; ++q) d.push_back({dis(gen), to_string(q)});
+  auto exp = d;
+  stable_sort(begin(exp), end(exp),
+              [](R const& a, R const& b) { return a.key < b.key; });
+  auto same = [](R const& a, R const& b) {
+    return a.key == b.key && a.name == b.name;
+  };
+  DYNAMIC_SECTION(n << " records, stable") {
+    sort_range(stable_tag{}, begin(d), end(d), less<>(), &R::key);
+    REQUIRE(equal(begin(d), end(d), begin(exp), same));
+  }
+  DYNAMIC_SECTION(n << " records, unstable") {
+    sort_range(begin(d), end(d), less<>(), &R::key);
+    REQUIRE(is_sorted(begin(d), end(d),
+                      [](R const& a, R const& b) { return a.key < b.key; }));
+  }
+}
@@ -0,0 +1,35 @@
+#include <catch2/catch.hpp>
+
+#include "algo/top_k.hpp"
+
+#include <algorithm>
+#include <random>
+
+using namespace std;
+using namespace P;
+
+TEST_CASE("top_k", "[top_k]") {
+  mt19937 gen;
+  vector<int> v;
+  int n = GENERATE(0, 1, 2, 3, 15, 16, 17, 1 << 8);
+  gen.seed(n);
+  uniform_int_distribution dis(0, 20);
+  generate_n(back_inserter(v), n, [&dis, &gen]() { return dis(gen); });
+  auto exp = v;
+  sort(begin(exp), end(exp));
+  int k = GENERATE(0, 1, 2, 7, 1 << 8);
+  DYNAMIC_SECTION(n << " elements, k = " << k) {
+    auto res = top_k(begin(v), end(v), k);
+    REQUIRE(res.size() == (size_t)min(n, k));
+    REQUIRE(equal(begin(res), end(res), begin(exp)));
+  }
+}
+
+TEST_CASE("TopK streaming with comparator", "[top_k]") {
+  TopK<int, greater<int>> t(3);  // 3 largest
+  for (int x : {5, 1, 9, 7, 3, 9, 2}) t.push(x);
+  REQUIRE(t.full());
+  REQUIRE(t.top() == 7);
+  vector<int> exp{9, 9, 7};
+  REQUIRE(t.sorted() == exp);
+}